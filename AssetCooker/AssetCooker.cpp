@@ -0,0 +1,374 @@
+﻿// AssetCooker.cpp
+// (pch 없이 빌드: 헤드리스 리눅스 / Windows 공용 CLI)
+//================================================================================================
+// 오프라인 에셋 쿠커 — 소스 트리를 훑어 런타임 LoadOrCook이 읽는 쿡 파일을 미리 만든다
+//  - .fbx   : .mesh (StaticMesh)
+//             + 본이 있으면 .skel/.anim (SkeletonAsset), 본 없이 애니메이션만 있으면 .rigid.skel/.anim (RigidSkeletal)
+//  - 텍스처 : --out일 때만 그대로 복사 (BC 압축은 DirectXTex/WIC가 Windows 전용이라 하지 않는다)
+//  - 엔진과 같은 코드(AssimpImporterEx / SkeletonImport / CookedMesh / CookedSkeleton)와
+//    같은 옵션(flipUV / leftHanded / 압축 설정)으로 쓰므로 런타임이 그대로 최신으로 인정한다.
+//  - <out>/.cookcache : 입력별 (내용 해시, 크기, 설정, 출력 목록). 전부 같고 출력이 남아 있으면 건너뜀.
+//    실패한 입력은 기록하지 않아 다음 실행에 다시 시도한다.
+//  - 입력 단위로 WorkerPool::ParallelFor (입력 하나는 한 스레드).
+//
+// 사용법: AssetCooker <srcDir> [--out <dir>] [-j <threads>] [--resample <keys/sec>]
+//                     [--resample-rig <rel.fbx> <keys/sec>]... [--force]
+//  --out          : 쿡 파일을 <dir>에 소스 트리 구조 그대로 (기본: 소스 옆 = 런타임이 찾는 자리)
+//  --resample     : 전 리그의 AnimCompressSettings::resampleRate (기본 0 = 끔, 앱 기본값과 같다)
+//  --resample-rig : 그 입력(소스 루트 기준 경로)만 리샘플. 앱에서 SetAnimCompressSettings(fbxPath, cs)로
+//                   opt-in한 리그와 같은 값을 줘야 .anim 스탬프가 맞는다
+//  --force        : 캐시 무시하고 전부 다시 쿡
+//================================================================================================
+#include "AssimpImporterEX.h"
+#include "CookedFile.h"
+#include "CookedMesh.h"
+#include "CookedSkeleton.h"
+#include "SkeletonImport.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+namespace fs = std::filesystem;
+
+static constexpr const char* kCacheName = ".cookcache";
+static constexpr const char* kCacheHeader = "AssetCooker 1";
+
+// 런타임과 같은 임포트 옵션 (ResourceManager::LoadStaticMesh / 씬 BuildAll)
+static constexpr bool kFlipUV = true;
+static constexpr bool kLeftHanded = true;
+
+enum class InputKind { Model, Texture };
+
+struct CookJob
+{
+    fs::path src;
+    std::string rel;      // 소스 루트 기준 (generic UTF-8) = 캐시 키
+    InputKind kind = InputKind::Model;
+};
+
+struct CacheEntry
+{
+    uint64_t hash = 0, size = 0;
+    uint32_t settings = 0;            // 포맷 버전 + 옵션 해시. 바뀌면 전부 다시 쿡
+    std::vector<std::string> outputs; // 출력 루트 기준 (generic UTF-8)
+};
+
+struct CookResult
+{
+    enum Status { Skipped, Cooked, Failed } status = Failed;
+    CacheEntry entry;
+    std::string message;
+    double ms = 0.0;
+};
+
+struct CookOptions
+{
+    fs::path srcRoot, outRoot;
+    bool copyTextures = false;        // --out일 때만
+    bool force = false;
+    unsigned threads = 0;
+    AnimCompressSettings cs;
+    std::unordered_map<std::string, float> resampleByRig; // rel (generic UTF-8) -> resampleRate
+
+    AnimCompressSettings SettingsFor(const std::string& rel) const
+    {
+        AnimCompressSettings r = cs;
+        const auto it = resampleByRig.find(rel);
+        if (it != resampleByRig.end()) r.resampleRate = it->second;
+        return r;
+    }
+};
+
+// fs::path <-> 엔진 API의 wstring. path::wstring()은 리눅스(libstdc++)에서 비ASCII면 예외라 UTF-8을 거친다
+static std::wstring WidePath(const fs::path& p) { return CookedFile::FromUtf8(p.u8string()); }
+static fs::path FsPath(const std::wstring& w) { return fs::u8path(CookedFile::ToUtf8(w)); }
+
+static std::string Lower(std::string s)
+{
+    for (char& c : s) if (c >= 'A' && c <= 'Z') c = char(c - 'A' + 'a');
+    return s;
+}
+
+static bool IsTexture(const std::string& ext)
+{
+    return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".dds" || ext == ".tga" || ext == ".bmp";
+}
+
+// ===== 캐시 (.cookcache) =====
+// 한 줄 = 입력 하나: hash \t size \t settings \t rel \t out0 \t out1 ...
+static std::unordered_map<std::string, CacheEntry> LoadCache(const fs::path& path)
+{
+    std::unordered_map<std::string, CacheEntry> cache;
+    std::ifstream in(path, std::ios::binary);
+    std::string line;
+    if (!in || !std::getline(in, line) || line != kCacheHeader) return cache; // 없음/다른 버전 = 빈 캐시
+
+    while (std::getline(in, line)) {
+        std::vector<std::string> f;
+        for (size_t b = 0;;) {
+            const size_t e = line.find('\t', b);
+            f.push_back(line.substr(b, e - b));
+            if (e == std::string::npos) break;
+            b = e + 1;
+        }
+        if (f.size() < 4) continue;
+        CacheEntry c;
+        c.hash = std::strtoull(f[0].c_str(), nullptr, 16);
+        c.size = std::strtoull(f[1].c_str(), nullptr, 10);
+        c.settings = (uint32_t)std::strtoul(f[2].c_str(), nullptr, 16);
+        c.outputs.assign(f.begin() + 4, f.end());
+        cache[f[3]] = std::move(c);
+    }
+    return cache;
+}
+
+static bool SaveCache(const fs::path& path, const std::vector<CookJob>& jobs, const std::vector<CookResult>& results)
+{
+    std::string s = std::string(kCacheHeader) + "\n";
+    char buf[64];
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        const CookResult& r = results[i];
+        if (r.status == CookResult::Failed) continue;
+        std::snprintf(buf, sizeof(buf), "%016llx\t%llu\t%08x\t",
+            (unsigned long long)r.entry.hash, (unsigned long long)r.entry.size, r.entry.settings);
+        s += buf;
+        s += jobs[i].rel;
+        for (const std::string& o : r.entry.outputs) { s += '\t'; s += o; }
+        s += '\n';
+    }
+    return CookedFile::WriteFileAtomic(WidePath(path), s.data(), s.size());
+}
+
+// 쿡 결과에 영향을 주는 것 전부 (포맷 버전 + 임포트/압축 옵션)
+static uint32_t ModelSettings(const AnimCompressSettings& cs)
+{
+    const uint32_t v[5] = {
+        CookedMesh::kVersion, CookedSkeleton::kVersion, CookedMesh::Options(kFlipUV, kLeftHanded),
+        CookedSkeleton::AnimOptions(cs), 1 /*규칙: 본 -> skinned, 애니만 -> rigid*/
+    };
+    return (uint32_t)CookedFile::HashBytes(v, sizeof(v));
+}
+
+// ===== 입력 수집 =====
+static std::vector<CookJob> Scan(const CookOptions& o)
+{
+    std::vector<CookJob> jobs;
+    const fs::path outRel = o.copyTextures ? o.outRoot.lexically_relative(o.srcRoot) : fs::path();
+    const bool outInside = !outRel.empty() && *outRel.begin() != "..";
+
+    for (auto it = fs::recursive_directory_iterator(o.srcRoot, fs::directory_options::skip_permission_denied);
+        it != fs::recursive_directory_iterator(); ++it) {
+        if (!it->is_regular_file()) continue;
+
+        const fs::path rel = it->path().lexically_relative(o.srcRoot);
+        if (outInside && std::mismatch(outRel.begin(), outRel.end(), rel.begin(), rel.end()).first == outRel.end())
+            continue; // 소스 안에 둔 출력 폴더
+
+        const std::string ext = Lower(it->path().extension().u8string());
+        CookJob j;
+        if (ext == ".fbx") j.kind = InputKind::Model;
+        else if (o.copyTextures && IsTexture(ext)) j.kind = InputKind::Texture;
+        else continue;
+
+        j.src = it->path();
+        j.rel = rel.generic_u8string();
+        jobs.push_back(std::move(j));
+    }
+    // 실행마다 같은 순서 (캐시 파일 diff / 로그 비교용)
+    std::sort(jobs.begin(), jobs.end(), [](const CookJob& a, const CookJob& b) { return a.rel < b.rel; });
+    return jobs;
+}
+
+// ===== 쿡 =====
+// FBX는 한 번만 읽는다: 스켈레톤 플래그로 읽어 본/애니메이션 유무를 보고 스켈레톤을 뽑은 뒤,
+// 같은 씬에 메시 쪽에만 있는 후처리(Debone, LimitBoneWeights)를 더 걸어 정적 메시를 만든다.
+static void CookModel(const CookJob& j, const fs::path& outBase, const SourceStamp& content,
+    const AnimCompressSettings& cs, std::vector<std::wstring>& outputs)
+{
+    const std::wstring baseW = WidePath(outBase);
+    const unsigned skelFlags = SkeletonImport::ImportFlags();
+    const unsigned meshFlags = AssimpImporterEx::ImportFlags(kFlipUV, kLeftHanded);
+    if ((skelFlags & ~meshFlags) != 0) throw std::runtime_error("skeleton import flags are not a subset of mesh flags");
+
+    Assimp::Importer imp;
+    const aiScene* sc = imp.ReadFile(j.src.u8string().c_str(), skelFlags);
+    if (!sc || !sc->mRootNode) throw std::runtime_error(std::string("assimp: ") + imp.GetErrorString());
+
+    // 1) 스켈레톤 + 클립 (본/애니메이션이 있을 때만. 파일 단위로 이미 병렬이라 워커는 0)
+    bool hasBones = false;
+    for (unsigned i = 0; i < sc->mNumMeshes && !hasBones; ++i)
+        hasBones = sc->mMeshes[i]->HasBones();
+    const bool hasSkeleton = hasBones || sc->mNumAnimations > 0;
+    const bool skinned = hasBones;
+    SkeletonCPU cpu;
+    if (hasSkeleton) SkeletonImport::FromScene(sc, skinned, cs, cpu, 0);
+
+    // 2) 정적 메시 (임포터 설정은 후처리 시점에 읽히므로 여기서 맞춰도 된다)
+    AssimpImporterEx::ConfigureImporter(imp);
+    sc = imp.ApplyPostProcessing(meshFlags & ~skelFlags);
+    if (!sc) throw std::runtime_error(std::string("assimp: ") + imp.GetErrorString());
+    MeshData_PNTT mesh;
+    AssimpImporterEx::ConvertScene_PNTT_AndMaterials(sc, mesh);
+    SourceStamp meshStamp = content;
+    meshStamp.options = CookedMesh::Options(kFlipUV, kLeftHanded);
+    const std::wstring meshPath = CookedFile::CookedPath(baseW, L".mesh");
+    if (!CookedMesh::Write(meshPath, mesh, meshStamp)) throw std::runtime_error("write .mesh failed");
+    outputs.push_back(meshPath);
+
+    if (!hasSkeleton) return;
+
+    SourceStamp skelStamp = content, animStamp = content;
+    skelStamp.options = CookedSkeleton::SkelOptions(skinned);
+    animStamp.options = CookedSkeleton::AnimOptions(cs);
+    const std::wstring skelPath = CookedSkeleton::SkelPath(baseW, skinned);
+    const std::wstring animPath = CookedSkeleton::AnimPath(baseW);
+    if (!CookedSkeleton::WriteSkel(skelPath, cpu, skelStamp)) throw std::runtime_error("write .skel failed");
+    if (!CookedSkeleton::WriteAnim(animPath, *cpu.clips, animStamp)) throw std::runtime_error("write .anim failed");
+    outputs.push_back(skelPath);
+    outputs.push_back(animPath);
+}
+
+static CookResult CookOne(const CookJob& j, const CookOptions& o,
+    const std::unordered_map<std::string, CacheEntry>& cache)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    const AnimCompressSettings cs = o.SettingsFor(j.rel); // --resample-rig이면 이 입력만 다르다
+    CookResult r;
+    try {
+        SourceStamp content;
+        if (!CookedFile::StampSource(WidePath(j.src), 0, content)) throw std::runtime_error("cannot read source");
+        r.entry.hash = content.hash;
+        r.entry.size = content.size;
+        r.entry.settings = (j.kind == InputKind::Model) ? ModelSettings(cs) : 0;
+
+        // 캐시 히트: 내용/설정이 같고 출력이 전부 남아 있음
+        const auto it = cache.find(j.rel);
+        if (!o.force && it != cache.end()) {
+            const CacheEntry& c = it->second;
+            bool hit = c.hash == r.entry.hash && c.size == r.entry.size && c.settings == r.entry.settings;
+            for (size_t k = 0; hit && k < c.outputs.size(); ++k)
+                hit = fs::exists(o.outRoot / fs::u8path(c.outputs[k]));
+            if (hit) {
+                r.entry.outputs = c.outputs;
+                r.status = CookResult::Skipped;
+                return r;
+            }
+        }
+
+        const fs::path outBase = o.outRoot / fs::u8path(j.rel);
+        fs::create_directories(outBase.parent_path());
+
+        std::vector<std::wstring> outputs;
+        if (j.kind == InputKind::Model) {
+            CookModel(j, outBase, content, cs, outputs);
+        }
+        else {
+            fs::copy_file(j.src, outBase, fs::copy_options::overwrite_existing);
+            outputs.push_back(WidePath(outBase));
+        }
+
+        for (const std::wstring& w : outputs)
+            r.entry.outputs.push_back(FsPath(w).lexically_relative(o.outRoot).generic_u8string());
+        r.status = CookResult::Cooked;
+    }
+    catch (const std::exception& e) {
+        r.status = CookResult::Failed;
+        r.message = e.what();
+    }
+    r.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    return r;
+}
+
+static void PrintUsage()
+{
+    std::fprintf(stderr,
+        "usage: AssetCooker <srcDir> [--out <dir>] [-j <threads>] [--resample <keys/sec>]\n"
+        "                   [--resample-rig <rel.fbx> <keys/sec>]... [--force]\n");
+}
+
+static bool ParseArgs(int argc, char** argv, CookOptions& o)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (a == "--out" && hasValue) { o.outRoot = fs::u8path(argv[++i]); o.copyTextures = true; }
+        else if (a == "-j" && hasValue) o.threads = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        else if (a == "--resample" && hasValue) o.cs.resampleRate = std::strtof(argv[++i], nullptr);
+        else if (a == "--resample-rig" && i + 2 < argc) {
+            const std::string rel = fs::u8path(argv[i + 1]).lexically_normal().generic_u8string();
+            o.resampleByRig[rel] = std::strtof(argv[i + 2], nullptr);
+            i += 2;
+        }
+        else if (a == "--force") o.force = true;
+        else if (!a.empty() && a[0] != '-' && o.srcRoot.empty()) o.srcRoot = fs::u8path(a);
+        else return false;
+    }
+    if (o.srcRoot.empty()) return false;
+
+    o.srcRoot = o.srcRoot.lexically_normal();
+    o.outRoot = o.copyTextures ? o.outRoot.lexically_normal() : o.srcRoot;
+    if (o.copyTextures && fs::weakly_canonical(o.outRoot) == fs::weakly_canonical(o.srcRoot))
+        o.copyTextures = false; // --out이 소스 자체면 제자리 모드
+    if (o.threads == 0) o.threads = (std::max)(1u, std::thread::hardware_concurrency());
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    CookOptions o;
+    if (!ParseArgs(argc, argv, o)) { PrintUsage(); return 2; }
+    if (!fs::is_directory(o.srcRoot)) {
+        std::fprintf(stderr, "AssetCooker: not a directory: %s\n", o.srcRoot.u8string().c_str());
+        return 2;
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const std::vector<CookJob> jobs = Scan(o);
+    const fs::path cachePath = o.outRoot / kCacheName;
+    const auto cache = LoadCache(cachePath);
+
+    std::vector<CookResult> results(jobs.size());
+    std::mutex logMutex;
+    WorkerPool pool(jobs.size() > 1 ? (std::min)(o.threads, (unsigned)jobs.size()) - 1 : 0u);
+    pool.ParallelFor(jobs.size(), 1, [&](size_t b, size_t e) {
+        for (size_t i = b; i < e; ++i) {
+            results[i] = CookOne(jobs[i], o, cache);
+
+            const CookResult& r = results[i];
+            std::lock_guard<std::mutex> lk(logMutex);
+            if (r.status == CookResult::Failed)
+                std::fprintf(stderr, "[fail] %s: %s\n", jobs[i].rel.c_str(), r.message.c_str());
+            else
+                std::printf("[%s] %s %.1f ms (%zu out)\n", (r.status == CookResult::Cooked) ? "cook" : "skip",
+                    jobs[i].rel.c_str(), r.ms, r.entry.outputs.size());
+        }
+    });
+
+    if (!SaveCache(cachePath, jobs, results))
+        std::fprintf(stderr, "AssetCooker: cannot write %s\n", cachePath.u8string().c_str());
+
+    size_t cooked = 0, skipped = 0, failed = 0;
+    for (const CookResult& r : results) {
+        if (r.status == CookResult::Cooked) ++cooked;
+        else if (r.status == CookResult::Skipped) ++skipped;
+        else ++failed;
+    }
+    const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::printf("AssetCooker: %zu inputs, %zu cooked, %zu skipped, %zu failed, %.2f s (%u threads)\n",
+        jobs.size(), cooked, skipped, failed, sec, pool.Workers() + 1);
+    return failed ? 1 : 0;
+}
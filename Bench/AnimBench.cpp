@@ -0,0 +1,542 @@
+﻿// AnimBench.cpp
+// 애니메이션 포즈 패스 벤치 (헤드리스, 최적화 빌드)
+//  AnimBench [section ...]   (인자 없으면 all)
+//  숫자는 parallel 외에는 단일 스레드 평균. 출력은 표 하나씩, 섹션 순서대로.
+//  cache 섹션의 미스 수는 리눅스 하드웨어 카운터 (perf_event_open). 못 열면 n/a + 이유.
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchRig.h"
+#include "WorkerPool.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace DirectX;
+
+static volatile float gSink = 0.0f; // 최적화로 샘플이 사라지지 않게
+
+static uint32_t NextRand(uint32_t& s) { return s = s * 1664525u + 1013904223u; }
+
+// ===== 벤치 리그: 합성 64노드 + Resource의 스킨 FBX (있으면) =====
+struct NamedRig
+{
+	std::string name;
+	BenchRig rig;
+};
+
+static const std::vector<NamedRig>& Rigs()
+{
+	static const std::vector<NamedRig> s_rigs = [] {
+		std::vector<NamedRig> rigs;
+		const AnimCompressSettings cs;
+
+		BenchRig syn = BenchRig::FromSkeleton(BenchRigs::Synthetic(64));
+		std::vector<AnimClip> clips;
+		clips.push_back(BenchRigs::SyntheticClip(syn, 4.0, 30.0, cs));
+		syn.SetClips(AnimClipLibrary::FromClips(std::move(clips)));
+		rigs.push_back({ "synthetic64", std::move(syn) });
+
+#if defined(BENCH_RESOURCE_DIR)
+		for (const char* rel : { "Skinning/SkinningTest.fbx", "BoxHuman/BoxHuman.fbx" }) {
+			SkeletonCPU cpu;
+			if (BenchRigs::LoadFBX(std::string(BENCH_RESOURCE_DIR) + "/" + rel, true, cs, cpu) && cpu.clips && cpu.clips->Count() > 0)
+				rigs.push_back({ rel, BenchRig::FromSkeleton(cpu) });
+		}
+#endif
+		return rigs;
+		}();
+	return s_rigs;
+}
+
+// 클립 0을 길이 1/3 지점에서 샘플한 로컬 포즈
+static std::vector<PoseMath::PoseTRS> SamplePose(const BenchRig& rig)
+{
+	const AnimClip& clip = *rig.clips->Get(0);
+	std::vector<AnimCursor> cursors(clip.channels.size());
+	std::vector<PoseMath::PoseTRS> local(rig.NodeCount());
+	clip.SampleLocalPose(float(clip.duration / 3.0), cursors.data(), rig.bindPose.data(), true, local.data());
+	return local;
+}
+
+// ===== cliplen: 클립 길이 vs 포즈당 샘플 비용 =====
+// 재생(커서 전진)은 키 개수와 무관하게 평평해야 하고, 임의 시킹도 이분 탐색이라 log로만 는다.
+// 비교용 "linear"는 예전 경로(매 샘플 0번 키부터 선형 upper bound)의 탐색 비용만 따로 잰 것.
+static float LinearSearchAll(const AnimClip& clip, float tTick)
+{
+	float acc = 0.0f;
+	for (const AnimChannel& ch : clip.channels) {
+		const AnimTrack* tracks[3] = { &ch.T, &ch.R, &ch.S };
+		for (const AnimTrack* tr : tracks) {
+			if (tr->count < 2) continue;
+			const float* ts = clip.times.data() + tr->timeOffset;
+			uint32_t ub = 0;
+			while (ub < tr->count && ts[ub] <= tTick) ++ub;
+			acc += (float)ub;
+		}
+	}
+	return acc;
+}
+
+static void BenchClipLength()
+{
+	const BenchRig rig = BenchRig::FromSkeleton(BenchRigs::Synthetic(64));
+	const AnimCompressSettings cs; // 키 제거 + 시간열 (리샘플 끔)
+	constexpr int kFrames = 4000;
+
+	std::printf("\n[cliplen] %zu nodes, 30 keys/s, per-pose SampleLocalPose (us)\n", rig.NodeCount());
+	std::printf("%10s %12s %12s %12s %14s\n", "clip(s)", "keys/track", "playback", "seek", "linear search");
+
+	for (double sec : { 2.0, 8.0, 32.0, 128.0, 512.0 }) {
+		const AnimClip clip = BenchRigs::SyntheticClip(rig, sec, 30.0, cs);
+
+		size_t rKeys = 0;
+		for (const AnimChannel& ch : clip.channels) rKeys += ch.R.count;
+		const double keysPerTrack = clip.channels.empty() ? 0.0 : double(rKeys) / clip.channels.size();
+
+		std::vector<AnimCursor> cursors(clip.channels.size());
+		std::vector<PoseMath::PoseTRS> local(rig.NodeCount());
+		const float dtTick = float(clip.ticksPerSec / 60.0);
+		const float dur = (float)clip.duration;
+
+		// 재생: 60fps로 전진, 끝에서 감김
+		float t = 0.0f;
+		double t0 = BenchRigs::NowMs();
+		for (int f = 0; f < kFrames; ++f) {
+			clip.SampleLocalPose(t, cursors.data(), rig.bindPose.data(), true, local.data());
+			gSink = gSink + local[0].r.x;
+			t += dtTick;
+			if (t > dur) t = std::fmod(t, dur);
+		}
+		const double playUs = (BenchRigs::NowMs() - t0) * 1000.0 / kFrames;
+
+		// 시킹: 매 샘플 임의 시각
+		uint32_t s = 7;
+		std::vector<float> seekT(kFrames);
+		for (float& v : seekT) v = dur * float(NextRand(s) >> 8) / float(1u << 24);
+		t0 = BenchRigs::NowMs();
+		for (int f = 0; f < kFrames; ++f) {
+			clip.SampleLocalPose(seekT[f], cursors.data(), rig.bindPose.data(), true, local.data());
+			gSink = gSink + local[0].r.x;
+		}
+		const double seekUs = (BenchRigs::NowMs() - t0) * 1000.0 / kFrames;
+
+		// 예전 선형 탐색 (탐색만, 클립 전체에 고르게 퍼진 시각으로)
+		const int linFrames = (std::max)(64, kFrames / int(1 + keysPerTrack / 64));
+		t0 = BenchRigs::NowMs();
+		for (int f = 0; f < linFrames; ++f)
+			gSink = gSink + LinearSearchAll(clip, seekT[f]);
+		const double linUs = (BenchRigs::NowMs() - t0) * 1000.0 / linFrames;
+
+		std::printf("%10.0f %12.0f %12.2f %12.2f %14.2f\n", sec, keysPerTrack, playUs, seekUs, linUs);
+	}
+}
+
+// ===== nlerp: 배치 샘플링(SoA nlerp) vs 기준(채널별 slerp) =====
+// 포즈 하나당 시간, 커서가 앞으로 걷는 재생 패턴. 정확도는 AnimTest가 검사한다.
+static void BenchNlerp()
+{
+	constexpr int kSamples = 240;
+	constexpr int kIters = 20;
+
+	std::printf("\n[nlerp] per-pose local sample (us)\n");
+	std::printf("%-28s %7s %10s %12s %9s\n", "rig", "nodes", "slerp ref", "nlerp x4", "speedup");
+
+	for (const NamedRig& nr : Rigs()) {
+		const BenchRig& rig = nr.rig;
+		const AnimClip& clip = *rig.clips->Get(0);
+		std::vector<PoseMath::PoseTRS> local(rig.NodeCount());
+		std::vector<AnimCursor> cursors(clip.channels.size());
+
+		auto run = [&](bool batch) {
+			const double t0 = BenchRigs::NowMs();
+			for (int it = 0; it < kIters; ++it) {
+				for (int k = 0; k < kSamples; ++k) {
+					const float t = float(clip.duration * k / kSamples);
+					if (batch) clip.SampleLocalPose(t, cursors.data(), rig.bindPose.data(), true, local.data());
+					else clip.SampleLocalPoseRef(t, cursors.data(), rig.bindPose.data(), true, local.data());
+				}
+				gSink = gSink + local[0].r.x;
+			}
+			return (BenchRigs::NowMs() - t0) * 1000.0 / (double(kIters) * kSamples);
+			};
+		const double refUs = run(false);
+		const double batchUs = run(true);
+		std::printf("%-28s %7zu %10.3f %12.3f %8.2fx\n", nr.name.c_str(), rig.NodeCount(), refUs, batchUs, refUs / batchUs);
+	}
+}
+
+// ===== hierarchy: 로컬 -> 글로벌 =====
+// 예전 재귀(std::function DFS) vs 부모 인덱스 선형 1패스 vs 인스턴스 배치 vs 동적 노드만(EvaluatePose 경로)
+// (a)~(c)는 행렬 로컬 포즈를 쓰는 비교용 변형이라 엔진(PoseMath)에는 없다. 엔진은 (d).
+
+// 인스턴스 하나: global[i] = local[i] * global[parent]
+static void LocalToGlobalMatrices(const int* parents, size_t n, const PoseMath::Matrix* local, PoseMath::Matrix* global)
+{
+	for (size_t i = 0; i < n; ++i) {
+		const XMMATRIX L = XMLoadFloat4x4(&local[i]);
+		const int p = parents[i];
+		XMStoreFloat4x4(&global[i], (p >= 0) ? XMMatrixMultiply(L, XMLoadFloat4x4(&global[p])) : L);
+	}
+}
+
+// 같은 스켈레톤 인스턴스 여러 개: 노드 바깥 / 인스턴스 안쪽.
+// parents[i]는 한 번만 읽고, 인스턴스끼리는 의존이 없어 곱셈이 파이프라인에서 겹친다.
+static void LocalToGlobalBatch(const int* parents, size_t n,
+	const PoseMath::Matrix* const* locals, PoseMath::Matrix* const* globals, size_t count)
+{
+	for (size_t i = 0; i < n; ++i) {
+		const int p = parents[i];
+		if (p < 0) {
+			for (size_t k = 0; k < count; ++k) globals[k][i] = locals[k][i];
+			continue;
+		}
+		for (size_t k = 0; k < count; ++k) {
+			const XMMATRIX L = XMLoadFloat4x4(&locals[k][i]);
+			XMStoreFloat4x4(&globals[k][i], XMMatrixMultiply(L, XMLoadFloat4x4(&globals[k][p])));
+		}
+	}
+}
+
+static void BenchHierarchy()
+{
+	using PoseMath::Matrix;
+	constexpr int kIters = 2000;
+	constexpr size_t kBatch = 64;
+
+	std::printf("\n[hierarchy] local -> global per instance (us)\n");
+	std::printf("%-28s %7s %9s %9s %11s %14s\n", "rig", "nodes", "DFS", "flat", "batch(x64)", "dynamic only");
+
+	for (const NamedRig& nr : Rigs()) {
+		const BenchRig& rig = nr.rig;
+		const size_t n = rig.NodeCount();
+		const std::vector<PoseMath::PoseTRS> pose = SamplePose(rig);
+
+		std::vector<Matrix> local(n), global(n);
+		for (size_t i = 0; i < n; ++i) XMStoreFloat4x4(&local[i], PoseMath::ComposeAffine(pose[i]));
+
+		std::vector<std::vector<int>> children(n);
+		std::vector<int> roots;
+		for (size_t i = 0; i < n; ++i) {
+			if (rig.parents[i] >= 0) children[rig.parents[i]].push_back((int)i);
+			else roots.push_back((int)i);
+		}
+
+		// (a) 재귀 DFS
+		std::function<void(int)> dfs = [&](int u) {
+			for (int v : children[u]) {
+				XMStoreFloat4x4(&global[v], XMMatrixMultiply(XMLoadFloat4x4(&local[v]), XMLoadFloat4x4(&global[u])));
+				dfs(v);
+			}
+			};
+		double t0 = BenchRigs::NowMs();
+		for (int it = 0; it < kIters; ++it) {
+			for (int r : roots) { global[r] = local[r]; dfs(r); }
+			gSink = gSink + global[n - 1]._41;
+		}
+		const double dfsUs = (BenchRigs::NowMs() - t0) * 1000.0 / kIters;
+
+		// (b) 선형 1패스
+		t0 = BenchRigs::NowMs();
+		for (int it = 0; it < kIters; ++it) {
+			LocalToGlobalMatrices(rig.parents.data(), n, local.data(), global.data());
+			gSink = gSink + global[n - 1]._41;
+		}
+		const double flatUs = (BenchRigs::NowMs() - t0) * 1000.0 / kIters;
+
+		// (c) kBatch 인스턴스 동시 (인스턴스당)
+		std::vector<std::vector<Matrix>> globals(kBatch, std::vector<Matrix>(n));
+		std::vector<const Matrix*> lp(kBatch, local.data());
+		std::vector<Matrix*> gp(kBatch);
+		for (size_t k = 0; k < kBatch; ++k) gp[k] = globals[k].data();
+		const int batchIters = (std::max)(1, kIters / 16);
+		t0 = BenchRigs::NowMs();
+		for (int it = 0; it < batchIters; ++it) {
+			LocalToGlobalBatch(rig.parents.data(), n, lp.data(), gp.data(), kBatch);
+			gSink = gSink + globals[kBatch - 1][n - 1]._41;
+		}
+		const double batchUs = (BenchRigs::NowMs() - t0) * 1000.0 / (double(batchIters) * kBatch);
+
+		// (d) 정적 서브트리 제외: TRS에서 바로, 동적 노드만
+		std::vector<Matrix> gdyn = rig.bindGlobal;
+		t0 = BenchRigs::NowMs();
+		for (int it = 0; it < kIters; ++it) {
+			PoseMath::LocalToGlobalSubset(rig.parents.data(), rig.dynamicNodes.data(), rig.dynamicNodes.size(), pose.data(), gdyn.data());
+			gSink = gSink + gdyn[n - 1]._41;
+		}
+		const double dynUs = (BenchRigs::NowMs() - t0) * 1000.0 / kIters;
+
+		char dynCol[32];
+		std::snprintf(dynCol, sizeof(dynCol), "%.3f (%zu)", dynUs, rig.dynamicNodes.size());
+		std::printf("%-28s %7zu %9.3f %9.3f %11.3f %14s\n", nr.name.c_str(), n, dfsUs, flatUs, batchUs, dynCol);
+	}
+}
+
+// ===== parallel: 인스턴스 수 x 스레드 수 =====
+// AnimationSystem::Update의 병렬 구간과 같은 모양: 인스턴스마다 BenchPose::Evaluate를 ParallelFor로 (청크 1).
+// 하드웨어 스레드보다 많은 스레드 열은 시분할이라 느려지는 게 정상.
+static void BenchParallel()
+{
+	static const size_t kCounts[] = { 1, 16, 64, 256 };
+	static const unsigned kThreads[] = { 1, 2, 4, 8 };
+	constexpr int kFrames = 60;
+
+	for (const NamedRig& nr : Rigs()) {
+		const BenchRig& rig = nr.rig;
+		const AnimClip& clip = *rig.clips->Get(0);
+
+		std::printf("\n[parallel] %s (%zu nodes, %zu bones), ms/frame, hardware threads %u\n",
+			nr.name.c_str(), rig.NodeCount(), rig.boneNodes.size(), std::thread::hardware_concurrency());
+		std::printf("%10s", "inst\\thr");
+		for (unsigned t : kThreads) std::printf(" %9u", t);
+		std::printf("\n");
+
+		for (size_t count : kCounts) {
+			std::vector<BenchPose> poses(count);
+			for (BenchPose& p : poses) p.Init(rig, clip);
+
+			std::printf("%10zu", count);
+			for (unsigned threads : kThreads) {
+				WorkerPool pool(threads - 1); // 호출 스레드 포함 threads개
+				double t = 0.0;
+				auto frame = [&] {
+					pool.ParallelFor(count, 1, [&](size_t b, size_t e) {
+						for (size_t k = b; k < e; ++k) poses[k].Evaluate(rig, clip, t + 0.037 * k); // 인스턴스마다 다른 시간
+						});
+					t += 1.0 / 60.0;
+					};
+				frame(); // 워밍업
+				const double t0 = BenchRigs::NowMs();
+				for (int f = 0; f < kFrames; ++f) frame();
+				std::printf(" %9.3f", (BenchRigs::NowMs() - t0) / kFrames);
+				gSink = gSink + poses[count - 1].palette[0].m[0][3];
+			}
+			std::printf("\n");
+		}
+	}
+}
+
+// ===== cache: 콜드 테이블 분리 전/후 EvaluatePose의 캐시 미스 =====
+// 하드웨어 카운터 하나 (리눅스 perf_event_open: 이 스레드, 유저 모드만). 못 열면 Ok() == false, Error()에 이유.
+class PerfCounter
+{
+public:
+	PerfCounter(uint32_t type, uint64_t config)
+	{
+#if defined(__linux__)
+		perf_event_attr a;
+		std::memset(&a, 0, sizeof(a));
+		a.size = sizeof(a);
+		a.type = type;
+		a.config = config;
+		a.disabled = 1;
+		a.exclude_kernel = 1;
+		a.exclude_hv = 1;
+		mFd = (int)syscall(SYS_perf_event_open, &a, 0, -1, -1, 0);
+		if (mFd < 0) mErr = errno;
+#else
+		(void)type; (void)config;
+#endif
+	}
+	~PerfCounter()
+	{
+#if defined(__linux__)
+		if (mFd >= 0) close(mFd);
+#endif
+	}
+	PerfCounter(const PerfCounter&) = delete;
+	PerfCounter& operator=(const PerfCounter&) = delete;
+
+	bool Ok() const noexcept { return mFd >= 0; }
+	const char* Error() const
+	{
+#if defined(__linux__)
+		return std::strerror(mErr);
+#else
+		return "perf_event_open is Linux only";
+#endif
+	}
+
+	void Start()
+	{
+#if defined(__linux__)
+		if (mFd < 0) return;
+		ioctl(mFd, PERF_EVENT_IOC_RESET, 0);
+		ioctl(mFd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+	}
+	uint64_t Stop()
+	{
+		uint64_t v = 0;
+#if defined(__linux__)
+		if (mFd < 0) return 0;
+		ioctl(mFd, PERF_EVENT_IOC_DISABLE, 0);
+		if (read(mFd, &v, sizeof(v)) != (ssize_t)sizeof(v)) v = 0;
+#endif
+		return v;
+	}
+
+private:
+	int mFd = -1;
+	int mErr = 0;
+};
+
+#if defined(__linux__)
+static constexpr uint32_t kPerfHwCache = PERF_TYPE_HW_CACHE;
+static constexpr uint64_t kPerfL1dReadMiss = PERF_COUNT_HW_CACHE_L1D
+	| (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+static constexpr uint32_t kPerfHw = PERF_TYPE_HARDWARE;
+static constexpr uint64_t kPerfCacheMisses = PERF_COUNT_HW_CACHE_MISSES; // 보통 LLC
+#else
+static constexpr uint32_t kPerfHwCache = 0, kPerfHw = 0;
+static constexpr uint64_t kPerfL1dReadMiss = 0, kPerfCacheMisses = 0;
+#endif
+
+// user-017 이전 배치: 본 inverse bind가 이름(std::string)과 함께 본 구조체에 들어 있고,
+// 노드 구조체에도 바인드 TRS가 이름/자식 목록 사이에 섞여 있었다 (SK_Node / SK_Bone 그대로).
+struct PreSplitNode
+{
+	std::string name;
+	int parent = -1;
+	std::vector<int> children;
+	PoseMath::Matrix bindLocal;
+	PoseMath::PoseTRS bindTRS;
+	std::vector<int> partIndices;
+};
+struct PreSplitBone
+{
+	std::string name;
+	int node = -1;
+	PoseMath::Matrix offset;
+};
+
+struct PreSplitRig
+{
+	std::vector<PreSplitNode> nodes;
+	std::vector<PreSplitBone> bones;
+
+	explicit PreSplitRig(const BenchRig& rig)
+	{
+		nodes.resize(rig.NodeCount());
+		for (size_t i = 0; i < nodes.size(); ++i) {
+			PreSplitNode& nd = nodes[i];
+			nd.name = rig.names[i];
+			nd.parent = rig.parents[i];
+			XMStoreFloat4x4(&nd.bindLocal, PoseMath::ComposeAffine(rig.bindPose[i]));
+			nd.bindTRS = rig.bindPose[i];
+			if (nd.parent >= 0) nodes[nd.parent].children.push_back((int)i);
+		}
+		bones.resize(rig.boneNodes.size());
+		for (size_t i = 0; i < bones.size(); ++i) {
+			bones[i].name = rig.names[rig.boneNodes[i]];
+			bones[i].node = rig.boneNodes[i];
+			bones[i].offset = rig.boneOffsets[i];
+		}
+	}
+
+	// 분리 전 EvaluatePose: 샘플/계층은 같고, 팔레트가 본 구조체 배열을 건너뛰며 읽는다
+	void Evaluate(const BenchRig& rig, const AnimClip& clip, double tSec, BenchPose& pose) const
+	{
+		const double T = tSec * ((clip.ticksPerSec > 0.0) ? clip.ticksPerSec : 25.0);
+		const double t = (clip.duration > 0.0) ? std::fmod(T, clip.duration) : 0.0;
+		clip.SampleLocalPose((float)t, pose.cursors.data(), rig.bindPose.data(), true, pose.local.data());
+		PoseMath::LocalToGlobalSubset(rig.parents.data(), rig.dynamicNodes.data(), rig.dynamicNodes.size(),
+			pose.local.data(), pose.global.data());
+		for (size_t i = 0; i < bones.size(); ++i) {
+			const XMMATRIX G = XMLoadFloat4x4(&pose.global[bones[i].node]);
+			XMStoreFloat3x4(&pose.palette[i], XMMatrixMultiply(XMLoadFloat4x4(&bones[i].offset), G));
+		}
+	}
+};
+
+// 서로 다른 에셋 kAssets개 (각자 별도 할당) x 인스턴스 하나씩을 라운드 로빈으로 평가.
+// 에셋 하나만 돌리면 테이블이 L1에 남아 두 배치 차이가 안 보인다.
+static void BenchCache()
+{
+	constexpr size_t kAssets = 64;
+	constexpr int kFrames = 200;
+
+	PerfCounter l1d(kPerfHwCache, kPerfL1dReadMiss);
+	PerfCounter llc(kPerfHw, kPerfCacheMisses);
+	const bool counters = l1d.Ok() || llc.Ok();
+
+	for (const NamedRig& nr : Rigs()) {
+		const AnimClip& clip = *nr.rig.clips->Get(0);
+		std::vector<BenchRig> rigs(kAssets, nr.rig);
+		std::vector<PreSplitRig> pre;
+		pre.reserve(kAssets);
+		for (const BenchRig& r : rigs) pre.emplace_back(r);
+		std::vector<BenchPose> poses(kAssets);
+		for (size_t k = 0; k < kAssets; ++k) poses[k].Init(rigs[k], clip);
+
+		std::printf("\n[cache] %s (%zu nodes, %zu bones) x %zu assets, per EvaluatePose\n",
+			nr.name.c_str(), nr.rig.NodeCount(), nr.rig.boneNodes.size(), kAssets);
+		std::printf("%-10s %12s %12s %10s\n", "layout", "L1D misses", "LLC misses", "ns");
+
+		for (int layout = 0; layout < 2; ++layout) {
+			const bool split = layout == 1;
+			auto frame = [&](double t) {
+				for (size_t k = 0; k < kAssets; ++k) {
+					if (split) poses[k].Evaluate(rigs[k], clip, t + 0.037 * k);
+					else pre[k].Evaluate(rigs[k], clip, t + 0.037 * k, poses[k]);
+				}
+				};
+			frame(0.0); // 워밍업
+
+			l1d.Start(); llc.Start();
+			const double t0 = BenchRigs::NowMs();
+			for (int f = 0; f < kFrames; ++f) frame(f / 60.0);
+			const double ms = BenchRigs::NowMs() - t0;
+			const double l1dMiss = double(l1d.Stop()), llcMiss = double(llc.Stop());
+			gSink = gSink + poses[kAssets - 1].palette[0].m[0][3];
+
+			const double evals = double(kFrames) * kAssets;
+			char a[32] = "n/a", b[32] = "n/a";
+			if (l1d.Ok()) std::snprintf(a, sizeof(a), "%.1f", l1dMiss / evals);
+			if (llc.Ok()) std::snprintf(b, sizeof(b), "%.1f", llcMiss / evals);
+			std::printf("%-10s %12s %12s %10.1f\n", split ? "split" : "pre-split", a, b, ms * 1e6 / evals);
+		}
+	}
+	if (!counters)
+		std::printf("(hardware cache counters unavailable: %s. perf_event_paranoid / VM PMU?)\n", l1d.Error());
+}
+
+// ===== 진입 =====
+struct Section { const char* name; void (*run)(); };
+static const Section kSections[] = {
+	{ "cliplen", BenchClipLength },
+	{ "nlerp", BenchNlerp },
+	{ "hierarchy", BenchHierarchy },
+	{ "parallel", BenchParallel },
+	{ "cache", BenchCache },
+};
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> want(argv + 1, argv + argc);
+	if (want.empty()) want.push_back("all");
+
+	for (const std::string& w : want) {
+		bool found = false;
+		for (const Section& sec : kSections) {
+			if (w == "all" || w == sec.name) { sec.run(); found = true; }
+		}
+		if (!found) {
+			std::fprintf(stderr, "unknown section: %s (", w.c_str());
+			for (const Section& sec : kSections) std::fprintf(stderr, " %s", sec.name);
+			std::fprintf(stderr, " all )\n");
+			return 1;
+		}
+	}
+	return 0;
+}
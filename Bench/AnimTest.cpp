@@ -0,0 +1,99 @@
+﻿// AnimTest.cpp
+// 애니메이션 샘플링 정확도 테스트 (ctest). 실패하면 0이 아닌 값으로 끝난다.
+//  - nlerp: 배치 경로(SampleLocalPose, SoA nlerp + 큰 각 slerp)가 기준(SampleLocalPoseRef, 항상 slerp)과
+//    kNlerpMaxDeg에서 나오는 이론 상한 안에서 맞는지. T/S는 두 경로 모두 lerp라 같아야 한다.
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "BenchRig.h"
+
+using namespace DirectX;
+
+static int gFailures = 0;
+
+static void Check(bool ok, const char* what, const std::string& rig, double value, double bound)
+{
+	std::printf("  %-4s %-28s %-22s %.6f (bound %.6f)\n", ok ? "ok" : "FAIL", rig.c_str(), what, value, bound);
+	if (!ok) ++gFailures;
+}
+
+// 두 회전 사이 각 (도). 2 * asin(|qa - ±qb| / 2) (acos(dot)보다 작은 각에서 안정)
+static float AngleDeg(const XMFLOAT4A& a, const XMFLOAT4A& b)
+{
+	const XMVECTOR qa = XMLoadFloat4A(&a), qb = XMLoadFloat4A(&b);
+	const float d = XMVectorGetX(XMVector4Dot(qa, qb));
+	const float chord = XMVectorGetX(XMVector4Length((d < 0.0f) ? XMVectorAdd(qa, qb) : XMVectorSubtract(qa, qb)));
+	return XMConvertToDegrees(2.0f * std::asin((std::min)(1.0f, chord * 0.5f)));
+}
+
+// 회전각 theta인 두 키 사이 nlerp의 최대 각 오차 (도). 쿼터니언 반각 phi = theta/2에서
+// nlerp 방향 = atan2(u sin phi, (1-u) + u cos phi), slerp = u phi. 최대는 u 안쪽에서 -> 촘촘히 찍어 본다.
+static double NlerpMaxErrorDeg(double thetaDeg)
+{
+	const double phi = thetaDeg * 3.14159265358979 / 360.0;
+	double worst = 0.0;
+	for (int k = 1; k < 1000; ++k) {
+		const double u = k / 1000.0;
+		const double a = std::atan2(u * std::sin(phi), (1.0 - u) + u * std::cos(phi));
+		worst = (std::max)(worst, std::fabs(a - u * phi));
+	}
+	return worst * 2.0 * 180.0 / 3.14159265358979; // 반각 -> 회전각
+}
+
+static void TestNlerp(const std::string& name, const BenchRig& rig, const AnimClip& clip)
+{
+	constexpr int kSamples = 600;
+	// 두 경로 모두 같은 양자화 키를 읽으므로 차이는 보간 방식 + float 반올림뿐
+	const double boundR = NlerpMaxErrorDeg(AnimClip::kNlerpMaxDeg) + 0.01;
+	constexpr double kBoundT = 1e-5;
+	constexpr double kBoundS = 1e-5;
+
+	const size_t n = rig.NodeCount();
+	std::vector<PoseMath::PoseTRS> ref(n), bat(n);
+	std::vector<AnimCursor> curRef(clip.channels.size()), curBat(clip.channels.size());
+
+	double maxR = 0.0, maxT = 0.0, maxS = 0.0;
+	for (int k = 0; k < kSamples; ++k) {
+		const float t = float(clip.duration * k / (kSamples - 1));
+		clip.SampleLocalPoseRef(t, curRef.data(), rig.bindPose.data(), true, ref.data());
+		clip.SampleLocalPose(t, curBat.data(), rig.bindPose.data(), true, bat.data());
+		for (size_t i = 0; i < n; ++i) {
+			maxR = (std::max)(maxR, (double)AngleDeg(ref[i].r, bat[i].r));
+			maxT = (std::max)(maxT, (double)XMVectorGetX(XMVector3Length(
+				XMVectorSubtract(XMLoadFloat3(&ref[i].t), XMLoadFloat3(&bat[i].t)))));
+			maxS = (std::max)(maxS, (double)XMVectorGetX(XMVector3Length(
+				XMVectorSubtract(XMLoadFloat3(&ref[i].s), XMLoadFloat3(&bat[i].s)))));
+		}
+	}
+	Check(maxR <= boundR, "nlerp R (deg)", name, maxR, boundR);
+	Check(maxT <= kBoundT, "nlerp T", name, maxT, kBoundT);
+	Check(maxS <= kBoundS, "nlerp S", name, maxS, kBoundS);
+}
+
+int main()
+{
+	const AnimCompressSettings cs;
+	std::printf("[nlerp] batch SampleLocalPose vs slerp reference\n");
+
+	// 합성: 촘촘한 키(작은 각, nlerp만) / 성긴 키(큰 각, slerp 대체 경로)
+	const BenchRig syn = BenchRig::FromSkeleton(BenchRigs::Synthetic(64));
+	TestNlerp("synthetic64 30 keys/s", syn, BenchRigs::SyntheticClip(syn, 4.0, 30.0, cs));
+	TestNlerp("synthetic64 1 key/s", syn, BenchRigs::SyntheticClip(syn, 8.0, 1.0, cs, 3));
+
+#if defined(BENCH_RESOURCE_DIR)
+	for (const char* rel : { "Skinning/SkinningTest.fbx", "BoxHuman/BoxHuman.fbx" }) {
+		SkeletonCPU cpu;
+		if (!BenchRigs::LoadFBX(std::string(BENCH_RESOURCE_DIR) + "/" + rel, true, cs, cpu) || !cpu.clips)
+			continue; // 리소스 없는 체크아웃이면 합성만
+		const BenchRig rig = BenchRig::FromSkeleton(cpu);
+		for (size_t c = 0; c < cpu.clips->Count(); ++c)
+			TestNlerp(std::string(rel) + " #" + std::to_string(c), rig, *cpu.clips->Get(c));
+	}
+#endif
+
+	std::printf("%s (%d failures)\n", gFailures ? "FAILED" : "passed", gFailures);
+	return gFailures ? 1 : 0;
+}
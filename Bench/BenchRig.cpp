@@ -0,0 +1,167 @@
+﻿// BenchRig.cpp
+#include "BenchRig.h"
+#include "CookedFile.h"
+#include "WorkerPool.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+#include <assimp/anim.h>
+
+using namespace DirectX;
+
+// ===== 리그 =====
+BenchRig BenchRig::FromSkeleton(const SkeletonCPU& cpu)
+{
+	BenchRig rig;
+	const size_t n = cpu.nodes.size();
+	rig.names.resize(n);
+	rig.parents.resize(n);
+	rig.bindPose.resize(n);
+	rig.bindGlobal.resize(n);
+	for (size_t i = 0; i < n; ++i) {
+		rig.names[i] = cpu.nodes[i].name;
+		rig.parents[i] = cpu.nodes[i].parent;
+		rig.bindPose[i] = PoseMath::DecomposeTRS(PoseMath::Matrix(cpu.nodes[i].bindLocal));
+	}
+	PoseMath::LocalToGlobal(rig.parents.data(), n, rig.bindPose.data(), rig.bindGlobal.data());
+
+	rig.boneNodes.resize(cpu.bones.size());
+	rig.boneOffsets.resize(cpu.bones.size());
+	for (size_t i = 0; i < cpu.bones.size(); ++i) {
+		rig.boneNodes[i] = cpu.bones[i].node;
+		rig.boneOffsets[i] = PoseMath::Matrix(cpu.bones[i].offset);
+	}
+	rig.SetClips(cpu.clips);
+	return rig;
+}
+
+void BenchRig::SetClips(std::shared_ptr<const AnimClipLibrary> lib)
+{
+	clips = std::move(lib);
+	const size_t n = parents.size();
+	const std::vector<uint8_t> animated = clips ? clips->AnimatedMask(n) : std::vector<uint8_t>(n, 1);
+	dynamicNodes = PoseMath::DynamicNodes(parents.data(), n, animated.data());
+}
+
+std::unordered_map<std::string, int> BenchRig::NameToNode() const
+{
+	std::unordered_map<std::string, int> m;
+	for (size_t i = 0; i < names.size(); ++i) m.emplace(names[i], (int)i);
+	return m;
+}
+
+// ===== 포즈 =====
+void BenchPose::Init(const BenchRig& rig, const AnimClip& clip)
+{
+	cursors.assign(clip.channels.size(), AnimCursor{});
+	local = rig.bindPose;
+	global = rig.bindGlobal;
+	palette.resize(rig.boneNodes.size());
+}
+
+void BenchPose::Evaluate(const BenchRig& rig, const AnimClip& clip, double tSec)
+{
+	const double T = tSec * ((clip.ticksPerSec > 0.0) ? clip.ticksPerSec : 25.0);
+	const double t = (clip.duration > 0.0) ? std::fmod(T, clip.duration) : 0.0;
+	clip.SampleLocalPose((float)t, cursors.data(), rig.bindPose.data(), /*bindTWhenMissing*/true, local.data());
+	PoseMath::LocalToGlobalSubset(rig.parents.data(), rig.dynamicNodes.data(), rig.dynamicNodes.size(),
+		local.data(), global.data());
+	PoseMath::SkinPalette(rig.boneNodes.data(), rig.boneOffsets.data(), rig.boneNodes.size(),
+		global.data(), palette.data());
+}
+
+// ===== 합성 =====
+static uint32_t NextRand(uint32_t& s) { return s = s * 1664525u + 1013904223u; }
+static float Rand01(uint32_t& s) { return float(NextRand(s) >> 8) / float(1u << 24); }
+
+SkeletonCPU BenchRigs::Synthetic(uint32_t nodeCount, uint32_t seed)
+{
+	SkeletonCPU cpu;
+	cpu.skinned = true;
+	XMStoreFloat4x4(&cpu.globalInv, XMMatrixIdentity());
+
+	uint32_t s = seed;
+	cpu.nodes.resize(nodeCount);
+	cpu.bones.resize(nodeCount);
+	std::vector<XMMATRIX> bindGlobal(nodeCount);
+	for (uint32_t i = 0; i < nodeCount; ++i) {
+		SkeletonCPU::Node& nd = cpu.nodes[i];
+		nd.name = "node" + std::to_string(i);
+		// 최근 8개 중 하나를 부모로: 팔다리처럼 깊은 체인 + 가지
+		nd.parent = (i == 0) ? -1 : (int)(i - 1 - (NextRand(s) >> 8) % std::min<uint32_t>(i, 8));
+		const XMVECTOR q = XMQuaternionRotationRollPitchYaw(0.3f * (Rand01(s) - 0.5f), 0.3f * (Rand01(s) - 0.5f), 0.0f);
+		const XMMATRIX L = XMMatrixMultiply(XMMatrixRotationQuaternion(q), XMMatrixTranslation(0.0f, 0.1f, 0.0f));
+		XMStoreFloat4x4(&nd.bindLocal, L);
+
+		bindGlobal[i] = (nd.parent >= 0) ? XMMatrixMultiply(L, bindGlobal[nd.parent]) : L;
+		cpu.bones[i].name = nd.name;
+		cpu.bones[i].node = (int)i;
+		XMStoreFloat4x4(&cpu.bones[i].offset, XMMatrixInverse(nullptr, bindGlobal[i]));
+	}
+	return cpu;
+}
+
+AnimClip BenchRigs::SyntheticClip(const BenchRig& rig, double seconds, double keysPerSec,
+	const AnimCompressSettings& cs, uint32_t seed)
+{
+	constexpr double kTicksPerSec = 30.0;
+	const uint32_t keys = (uint32_t)std::ceil(seconds * keysPerSec) + 1;
+	const double tickStep = kTicksPerSec / keysPerSec;
+	const size_t n = rig.NodeCount();
+
+	aiAnimation a; // 소멸자가 채널/키 배열을 지운다 (Assimp 소유 규칙 그대로)
+	a.mName.Set("synthetic");
+	a.mDuration = (keys - 1) * tickStep;
+	a.mTicksPerSecond = kTicksPerSec;
+	a.mNumChannels = (unsigned)n;
+	a.mChannels = new aiNodeAnim*[n];
+
+	uint32_t s = seed;
+	for (size_t c = 0; c < n; ++c) {
+		aiNodeAnim* na = new aiNodeAnim();
+		a.mChannels[c] = na;
+		na->mNodeName.Set(rig.names[c]);
+
+		const float w[3] = { 0.5f + 3.0f * Rand01(s), 0.5f + 3.0f * Rand01(s), 0.5f + 3.0f * Rand01(s) };
+		const float ph[3] = { 6.28f * Rand01(s), 6.28f * Rand01(s), 6.28f * Rand01(s) };
+		const XMFLOAT3& bt = rig.bindPose[c].t;
+
+		na->mNumPositionKeys = keys;
+		na->mNumRotationKeys = keys;
+		na->mPositionKeys = new aiVectorKey[keys];
+		na->mRotationKeys = new aiQuatKey[keys];
+		for (uint32_t k = 0; k < keys; ++k) {
+			const double tick = k * tickStep;
+			const float ts = float(tick / kTicksPerSec);
+			const float jitter = XMConvertToRadians(0.3f) * (Rand01(s) - 0.5f);
+			const XMVECTOR q = XMQuaternionRotationRollPitchYaw(
+				0.5f * std::sin(w[0] * ts + ph[0]) + jitter, 0.5f * std::sin(w[1] * ts + ph[1]), 0.3f * std::sin(w[2] * ts + ph[2]));
+			XMFLOAT4 qf;
+			XMStoreFloat4(&qf, q);
+			na->mRotationKeys[k] = aiQuatKey(tick, aiQuaternion(qf.w, qf.x, qf.y, qf.z));
+			na->mPositionKeys[k] = aiVectorKey(tick, aiVector3D(bt.x + 0.02f * std::sin(w[1] * ts), bt.y, bt.z + 0.02f * std::cos(w[2] * ts)));
+		}
+	}
+	return AnimClip::FromAssimp(&a, rig.NameToNode(), n, cs, rig.parents.data());
+}
+
+bool BenchRigs::LoadFBX(const std::string& utf8Path, bool skinned, const AnimCompressSettings& cs, SkeletonCPU& out)
+{
+	try {
+		SkeletonImport::FromFBX(CookedFile::FromUtf8(utf8Path), skinned, cs, out, WorkerPool::DefaultWorkers());
+		return true;
+	}
+	catch (const std::exception& e) {
+		std::fprintf(stderr, "%s: %s\n", utf8Path.c_str(), e.what());
+		return false;
+	}
+}
+
+double BenchRigs::NowMs()
+{
+	using namespace std::chrono;
+	return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
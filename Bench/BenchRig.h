@@ -0,0 +1,64 @@
+﻿// BenchRig.h
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "SkeletonImport.h"
+#include "AnimClip.h"
+#include "PoseMath.h"
+
+//================================================================================================
+// 헤드리스 벤치/테스트용 리그 — SkeletonAsset에서 D3D를 뺀 것
+//  - 포즈 패스가 읽는 연속 배열(parents / bindPose / bindGlobal / dynamicNodes / boneNodes / boneOffsets)을
+//    SkeletonAsset::LoadFromFBX와 같은 순서/함수로 만든다.
+//  - BenchPose::Evaluate = SkinnedSkeletal::EvaluatePose의 CPU 부분 (샘플 -> 동적 노드 글로벌 -> 팔레트).
+//  - 입력은 SkeletonImport(FBX) 또는 합성 리그. 합성 클립은 aiAnimation을 직접 만들어
+//    AnimClip::FromAssimp(압축 포함)를 그대로 태운다.
+//================================================================================================
+struct BenchRig
+{
+    std::vector<std::string> names;
+    std::vector<int> parents;                    // 위상 순서, 루트 -1
+    std::vector<PoseMath::PoseTRS> bindPose;
+    std::vector<PoseMath::Matrix> bindGlobal;
+    std::vector<int> dynamicNodes;               // 클립 채널이 있는 서브트리 (SetClips 때 다시 계산)
+    std::vector<int> boneNodes;                  // 본별 노드 인덱스
+    std::vector<PoseMath::Matrix> boneOffsets;   // 본별 inverse bind
+    std::shared_ptr<const AnimClipLibrary> clips;
+
+    static BenchRig FromSkeleton(const SkeletonCPU& cpu);
+
+    void SetClips(std::shared_ptr<const AnimClipLibrary> lib);
+    std::unordered_map<std::string, int> NameToNode() const;
+    size_t NodeCount() const noexcept { return parents.size(); }
+};
+
+// 인스턴스별 가변 상태 (PoseInstance에서 GPU 쪽을 뺀 것)
+struct BenchPose
+{
+    std::vector<AnimCursor> cursors;
+    std::vector<PoseMath::PoseTRS> local;
+    std::vector<PoseMath::Matrix> global;        // 정적 노드는 Init 때 바인드 글로벌로
+    std::vector<PoseMath::BoneMatrix> palette;
+
+    void Init(const BenchRig& rig, const AnimClip& clip);
+    void Evaluate(const BenchRig& rig, const AnimClip& clip, double tSec); // 루프 재생
+};
+
+namespace BenchRigs
+{
+    // 가지 치는 트리 nodeCount개 (부모 인덱스 < 자식), 전 노드가 본. 노드마다 짧은 뼈 길이 + 약간의 회전
+    SkeletonCPU Synthetic(uint32_t nodeCount, uint32_t seed = 1);
+
+    // 전 노드에 T/R 키를 keysPerSec 간격으로 (사인 합 + 작은 떨림 = 모션캡처 꼴, 키 제거가 거의 못 줄인다)
+    AnimClip SyntheticClip(const BenchRig& rig, double seconds, double keysPerSec,
+        const AnimCompressSettings& cs, uint32_t seed = 1);
+
+    // SkeletonImport::FromFBX (워커 DefaultWorkers). 실패하면 false (메시지는 stderr)
+    bool LoadFBX(const std::string& utf8Path, bool skinned, const AnimCompressSettings& cs, SkeletonCPU& out);
+
+    double NowMs();
+}
@@ -0,0 +1,50 @@
+﻿// CpuSkinningBench.cpp
+// CPU 스키닝 처리량 (한 스레드 = 코어당 정점/초). D3D/DirectXMath 없이 CpuSkinning.cpp만 링크.
+//  CpuSkinningBench [verts] [bones]   (기본 200000 정점, 64 본)
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "CpuSkinning.h"
+#include "RandomSkin.h"
+
+static volatile float gSink = 0.0f; // 최적화로 결과가 사라지지 않게
+
+int main(int argc, char** argv)
+{
+	const size_t verts = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 200000;
+	const uint32_t bones = (argc > 2) ? (uint32_t)std::strtoul(argv[2], nullptr, 10) : 64;
+	if (verts == 0 || bones == 0) { std::fprintf(stderr, "usage: CpuSkinningBench [verts] [bones]\n"); return 2; }
+
+	RandomSkin::Rng rng(1);
+	const std::vector<float> pal = RandomSkin::Palette(bones, rng);
+	const std::vector<VertexCPU_PNTT_BW> in = RandomSkin::Vertices(verts, bones, rng);
+	std::vector<CpuSkinning::SkinnedVertex> out(verts);
+
+	std::printf("[cpuskin] %zu verts, %u bones, 1 thread\n", verts, bones);
+	std::printf("%-8s %14s %10s\n", "kernel", "Mverts/s/core", "ns/vert");
+
+	for (CpuSkinning::Kernel k : { CpuSkinning::Kernel::Scalar, CpuSkinning::Kernel::AVX2 }) {
+		if (k == CpuSkinning::Kernel::AVX2 && !CpuSkinning::HasAVX2()) {
+			std::printf("%-8s %14s\n", CpuSkinning::ToString(k), "(no AVX2)");
+			continue;
+		}
+		CpuSkinning::Skin(k, in.data(), verts, pal.data(), out.data()); // 워밍업
+
+		// 최소 0.5초 분량을 돌려 평균
+		using Clock = std::chrono::steady_clock;
+		size_t done = 0;
+		const auto t0 = Clock::now();
+		double sec = 0.0;
+		do {
+			CpuSkinning::Skin(k, in.data(), verts, pal.data(), out.data());
+			gSink = gSink + out[verts - 1].px;
+			done += verts;
+			sec = std::chrono::duration<double>(Clock::now() - t0).count();
+		} while (sec < 0.5);
+
+		std::printf("%-8s %14.1f %10.2f\n", CpuSkinning::ToString(k), done / sec / 1e6, sec * 1e9 / done);
+	}
+	return 0;
+}
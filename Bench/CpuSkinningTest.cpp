@@ -0,0 +1,85 @@
+﻿// CpuSkinningTest.cpp
+// CpuSkinning 커널 일치 테스트 (ctest). D3D/DirectXMath 없이 CpuSkinning.cpp만 링크.
+//  - 스칼라 커널을 double 기준값과, AVX2 커널을 스칼라와 비교한다. 난수 팔레트/정점, 8의 배수가 아닌 길이 포함.
+//  - AVX2가 없는 CPU면 AVX2 비교는 건너뛴다 (종료 코드 77 = ctest SKIP).
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "CpuSkinning.h"
+#include "RandomSkin.h"
+
+using CpuSkinning::SkinnedVertex;
+
+static int gFailures = 0;
+
+static void Check(bool ok, const char* what, size_t count, double value, double bound)
+{
+	std::printf("  %-4s %-24s %7zu verts  max %.3g (bound %.3g)\n", ok ? "ok" : "FAIL", what, count, value, bound);
+	if (!ok) ++gFailures;
+}
+
+// 셰이더 수식 그대로, double로
+static void SkinReference(const VertexCPU_PNTT_BW& v, const float* pal, double out[10])
+{
+	double B[12] = {};
+	for (int k = 0; k < 4; ++k)
+		for (int c = 0; c < 12; ++c) B[c] += double(v.bw[k]) * pal[size_t(v.bi[k]) * 12 + c];
+	const double p[3] = { v.px, v.py, v.pz }, n[3] = { v.nx, v.ny, v.nz }, t[3] = { v.tx, v.ty, v.tz };
+	for (int r = 0; r < 3; ++r) {
+		out[r] = B[r * 4] * p[0] + B[r * 4 + 1] * p[1] + B[r * 4 + 2] * p[2] + B[r * 4 + 3];
+		out[3 + r] = B[r * 4] * n[0] + B[r * 4 + 1] * n[1] + B[r * 4 + 2] * n[2];
+		out[6 + r] = B[r * 4] * t[0] + B[r * 4 + 1] * t[1] + B[r * 4 + 2] * t[2];
+	}
+	out[9] = v.tw;
+}
+
+// 성분별 상대 오차 |a - b| / max(1, |b|)의 최대
+static double MaxRelDiff(const float* a, const double* b, int n)
+{
+	double m = 0.0;
+	for (int c = 0; c < n; ++c) m = (std::max)(m, std::fabs(a[c] - b[c]) / (std::max)(1.0, std::fabs(b[c])));
+	return m;
+}
+
+int main()
+{
+	// float 누적 (4본 x 12 + 3항 내적) 반올림 몇 ulp. FMA 유무로 두 커널 순서가 달라도 이 안이다
+	constexpr double kTol = 1e-5;
+	constexpr uint32_t kBones = 64;
+
+	const bool avx2 = CpuSkinning::HasAVX2();
+	std::printf("[cpuskin] scalar vs double reference, AVX2 vs scalar (AVX2 %s)\n", avx2 ? "available" : "not available");
+
+	RandomSkin::Rng rng(12345);
+	const std::vector<float> pal = RandomSkin::Palette(kBones, rng);
+
+	for (size_t count : { size_t(1), size_t(7), size_t(8), size_t(9), size_t(31), size_t(1000), size_t(10007) }) {
+		const std::vector<VertexCPU_PNTT_BW> in = RandomSkin::Vertices(count, kBones, rng);
+		std::vector<SkinnedVertex> sc(count), vx(count);
+		CpuSkinning::Skin(CpuSkinning::Kernel::Scalar, in.data(), count, pal.data(), sc.data());
+
+		double refDiff = 0.0;
+		for (size_t i = 0; i < count; ++i) {
+			double ref[10];
+			SkinReference(in[i], pal.data(), ref);
+			refDiff = (std::max)(refDiff, MaxRelDiff(&sc[i].px, ref, 10));
+		}
+		Check(refDiff <= kTol, "scalar vs reference", count, refDiff, kTol);
+
+		if (!avx2) continue;
+		CpuSkinning::Skin(CpuSkinning::Kernel::AVX2, in.data(), count, pal.data(), vx.data());
+		double kernDiff = 0.0;
+		for (size_t i = 0; i < count; ++i) {
+			double s[10];
+			for (int c = 0; c < 10; ++c) s[c] = (&sc[i].px)[c];
+			kernDiff = (std::max)(kernDiff, MaxRelDiff(&vx[i].px, s, 10));
+		}
+		Check(kernDiff <= kTol, "AVX2 vs scalar", count, kernDiff, kTol);
+	}
+
+	std::printf("%s (%d failures)\n", gFailures ? "FAILED" : "passed", gFailures);
+	if (gFailures) return 1;
+	return avx2 ? 0 : 77;
+}
@@ -0,0 +1,92 @@
+﻿// InfluenceBench.cpp
+// 스킨 가중치 수집 벤치: 합성 메시 (기본 정점 30만, 본 64, 정점당 영향 6개)로
+// 예전 정점별 vector + sort vs SkinInfluences::GatherTop4 (CSR 2패스). 두 결과가 다른 정점 수도 같이 출력.
+//  InfluenceBench [verts]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include "SkinInfluences.h"
+
+// ===== 예전 방식 (비교 기준) =====
+// 정점마다 vector<pair> + sort -> 상위 4개 정규화 (SkinInfluences.cpp WriteTop4와 같은 규칙)
+static void GatherTop4PerVertex(const InfluenceSpan* spans, size_t spanCount, uint32_t vertexCount,
+	VertexCPU_PNTT_BW* vtx)
+{
+	std::vector<std::vector<std::pair<int, float>>> infl(vertexCount);
+	for (size_t i = 0; i < spanCount; ++i) {
+		const InfluenceSpan& sp = spans[i];
+		for (uint32_t w = 0; w < sp.count; ++w) {
+			const aiVertexWeight& vw = sp.weights[w];
+			if (vw.mVertexId < vertexCount && vw.mWeight > 0.0f)
+				infl[vw.mVertexId].emplace_back((int)sp.bone, vw.mWeight);
+		}
+	}
+	for (uint32_t v = 0; v < vertexCount; ++v) {
+		auto& inf = infl[v];
+		std::sort(inf.begin(), inf.end(), [](auto& a, auto& b) { return a.second > b.second; });
+		const int n = (int)std::min<size_t>(inf.size(), 4);
+		float sum = 0.0f;
+		for (int k = 0; k < 4; ++k) {
+			vtx[v].bi[k] = (k < n) ? (uint16_t)inf[k].first : 0;
+			vtx[v].bw[k] = (k < n) ? inf[k].second : 0.0f;
+			sum += vtx[v].bw[k];
+		}
+		if (sum > 0.0f) {
+			for (int k = 0; k < 4; ++k) vtx[v].bw[k] /= sum;
+		}
+		else {
+			vtx[v].bi[0] = 0; vtx[v].bw[0] = 1.0f;
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	using Clock = std::chrono::steady_clock;
+	const uint32_t verts = (argc > 1) ? (uint32_t)std::strtoul(argv[1], nullptr, 10) : 300000;
+	constexpr uint32_t kBones = 64, kPerVertex = 6;
+	constexpr int kIters = 5;
+	if (verts == 0) { std::fprintf(stderr, "usage: InfluenceBench [verts]\n"); return 2; }
+
+	// 본별 가중치 목록 (정점마다 서로 다른 본 kPerVertex개, 가중치는 전부 다르게)
+	std::vector<std::vector<aiVertexWeight>> lists(kBones);
+	uint32_t rng = 12345u;
+	for (uint32_t v = 0; v < verts; ++v) {
+		const uint32_t first = (rng = rng * 1664525u + 1013904223u) >> 8;
+		for (uint32_t k = 0; k < kPerVertex; ++k) {
+			rng = rng * 1664525u + 1013904223u;
+			const float w = 0.05f + float(rng >> 8) / float(1u << 24);
+			lists[(first + k * 7) % kBones].push_back(aiVertexWeight(v, w));
+		}
+	}
+	std::vector<InfluenceSpan> spans(kBones);
+	for (uint32_t b = 0; b < kBones; ++b) spans[b] = { b, lists[b].data(), (uint32_t)lists[b].size() };
+
+	std::vector<VertexCPU_PNTT_BW> a(verts), c(verts);
+	InfluenceScratch scratch;
+
+	auto t0 = Clock::now();
+	for (int it = 0; it < kIters; ++it) GatherTop4PerVertex(spans.data(), spans.size(), verts, a.data());
+	auto t1 = Clock::now();
+	for (int it = 0; it < kIters; ++it) SkinInfluences::GatherTop4(spans.data(), spans.size(), verts, c.data(), scratch);
+	auto t2 = Clock::now();
+	const double perVertexMs = std::chrono::duration<double, std::milli>(t1 - t0).count() / kIters;
+	const double csrMs = std::chrono::duration<double, std::milli>(t2 - t1).count() / kIters;
+
+	size_t mismatch = 0;
+	for (uint32_t v = 0; v < verts; ++v) {
+		for (int k = 0; k < 4; ++k) {
+			if (a[v].bi[k] != c[v].bi[k] || std::fabs(a[v].bw[k] - c[v].bw[k]) > 1e-6f) { ++mismatch; break; }
+		}
+	}
+
+	std::printf("[influences] %u verts, %u bones, %u influences/vertex (ms)\n", verts, kBones, kPerVertex);
+	std::printf("%12s %10s %9s %10s\n", "per-vertex", "CSR", "speedup", "mismatch");
+	std::printf("%12.2f %10.2f %8.2fx %10zu\n", perVertexMs, csrMs, perVertexMs / csrMs, mismatch);
+	return 0;
+}
@@ -0,0 +1,76 @@
+﻿// RandomSkin.h
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "MeshDataEx.h"
+
+//================================================================================================
+// CpuSkinning 테스트/벤치용 난수 입력 (D3D/DirectXMath 없음)
+//  - 팔레트: 본당 3x4 행 (회전 + 0.5~1.5 균일 스케일 + 이동), CpuSkinning과 같은 float 12개 배치
+//  - 정점: 위치/노멀/탄젠트 난수, 영향 4개 (서로 다른 본, 합 1)
+//================================================================================================
+namespace RandomSkin
+{
+    struct Rng
+    {
+        uint32_t s;
+        explicit Rng(uint32_t seed) : s(seed) {}
+        uint32_t Next() { return s = s * 1664525u + 1013904223u; }
+        float Uniform(float lo, float hi) { return lo + (hi - lo) * float(Next() >> 8) / float(1u << 24); }
+    };
+
+    inline std::vector<float> Palette(uint32_t bones, Rng& rng)
+    {
+        std::vector<float> pal(size_t(bones) * 12);
+        for (uint32_t b = 0; b < bones; ++b) {
+            // 축-각 회전 (Rodrigues) * 스케일, 4열 = 이동
+            float ax = rng.Uniform(-1.0f, 1.0f), ay = rng.Uniform(-1.0f, 1.0f), az = rng.Uniform(-1.0f, 1.0f);
+            const float len = std::sqrt(ax * ax + ay * ay + az * az) + 1e-6f;
+            ax /= len; ay /= len; az /= len;
+            const float a = rng.Uniform(-3.14159f, 3.14159f), c = std::cos(a), s = std::sin(a), t = 1.0f - c;
+            const float sc = rng.Uniform(0.5f, 1.5f);
+            const float R[3][3] = {
+                { t * ax * ax + c,      t * ax * ay - s * az, t * ax * az + s * ay },
+                { t * ax * ay + s * az, t * ay * ay + c,      t * ay * az - s * ax },
+                { t * ax * az - s * ay, t * ay * az + s * ax, t * az * az + c      },
+            };
+            float* m = pal.data() + size_t(b) * 12;
+            for (int r = 0; r < 3; ++r) {
+                for (int k = 0; k < 3; ++k) m[r * 4 + k] = sc * R[r][k];
+                m[r * 4 + 3] = rng.Uniform(-2.0f, 2.0f);
+            }
+        }
+        return pal;
+    }
+
+    inline std::vector<VertexCPU_PNTT_BW> Vertices(size_t count, uint32_t bones, Rng& rng)
+    {
+        std::vector<VertexCPU_PNTT_BW> v(count);
+        for (VertexCPU_PNTT_BW& x : v) {
+            x.px = rng.Uniform(-1.0f, 1.0f); x.py = rng.Uniform(0.0f, 2.0f); x.pz = rng.Uniform(-1.0f, 1.0f);
+            x.nx = rng.Uniform(-1.0f, 1.0f); x.ny = rng.Uniform(-1.0f, 1.0f); x.nz = rng.Uniform(-1.0f, 1.0f);
+            x.u = rng.Uniform(0.0f, 1.0f); x.v = rng.Uniform(0.0f, 1.0f);
+            x.tx = rng.Uniform(-1.0f, 1.0f); x.ty = rng.Uniform(-1.0f, 1.0f); x.tz = rng.Uniform(-1.0f, 1.0f);
+            x.tw = (rng.Next() & 0x100) ? 1.0f : -1.0f;
+
+            float sum = 0.0f;
+            for (int k = 0; k < 4; ++k) {
+                // 같은 본이 두 번 나와도 커널은 상관없지만 실제 메시처럼 서로 다르게
+                uint16_t bi;
+                bool dup;
+                do {
+                    bi = uint16_t(rng.Next() % bones);
+                    dup = false;
+                    for (int j = 0; j < k; ++j) dup |= (x.bi[j] == bi);
+                } while (dup && bones >= 4);
+                x.bi[k] = bi;
+                x.bw[k] = rng.Uniform(0.0f, 1.0f);
+                sum += x.bw[k];
+            }
+            for (float& w : x.bw) w /= sum;
+        }
+        return v;
+    }
+}
@@ -0,0 +1,689 @@
+﻿// AnimClip.cpp
+// (오프라인 쿠커와 공용: Windows가 아니면 pch/Helper 대신 stderr 로그)
+#if defined(_WIN32)
+#include "../D3D_Core/pch.h"
+#include "../D3D_Core/Helper.h"
+#else
+#include <cstdio>
+#define LOG_MESSAGEA(fmt, ...) std::fprintf(stderr, fmt "\n", ##__VA_ARGS__)
+#endif
+#include "AnimClip.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <map>
+
+#include <assimp/scene.h>
+
+using namespace DirectX;
+
+// ===== 키프레임 upper bound (커서) =====
+// hint = 직전 샘플의 upper bound. 재생 중엔 앞/뒤로 몇 칸만 걷고,
+// 시크나 루프 랩처럼 멀리 튀면 이분 탐색으로 다시 잡는다.
+static int UpperBoundCursor(const float* times, int n, float t, int& hint)
+{
+	constexpr int kMaxWalk = 4;
+	int i = std::clamp(hint, 0, n);
+
+	int steps = 0;
+	while (i < n && times[i] <= t && steps < kMaxWalk) { ++i; ++steps; }
+	while (i > 0 && times[i - 1] > t && steps < kMaxWalk) { --i; ++steps; }
+
+	const bool hit = (i >= n || times[i] > t) && (i <= 0 || times[i - 1] <= t);
+	if (!hit) i = (int)(std::upper_bound(times, times + n, t) - times);
+
+	hint = i;
+	return i;
+}
+
+// ===== 균일 트랙 키 인덱스 =====
+// x = t * keyRate 를 [0, n-1]로 자르고 정수부 = 앞 키, 소수부 = 보간 계수. 분기/탐색 없음.
+static inline int UniformKey(float tTick, float keyRate, int n, float& u)
+{
+	const float x = std::clamp(tTick * keyRate, 0.0f, float(n - 1));
+	const int i = std::min((int)x, n - 2);
+	u = x - (float)i;
+	return i;
+}
+
+// ===== 양자화 =====
+static constexpr float kSqrt2 = 1.41421356f;
+static constexpr float kInvSqrt2 = 0.70710678f;
+static constexpr float kQ15 = 32767.0f;
+static constexpr float kQ16 = 65535.0f;
+
+// smallest-three: 가장 큰 성분은 나머지로 복원(부호는 q == -q 로 양수화)
+static AnimQuat48 PackQuat(const XMFLOAT4& q)
+{
+	const float c[4] = { q.x, q.y, q.z, q.w };
+	int big = 0;
+	for (int i = 1; i < 4; ++i) if (std::fabs(c[i]) > std::fabs(c[big])) big = i;
+	const float sgn = (c[big] < 0.0f) ? -1.0f : 1.0f;
+
+	uint64_t bits = (uint64_t)big << 45;
+	int shift = 30;
+	for (int i = 0; i < 4; ++i) {
+		if (i == big) continue;
+		const float s = std::clamp(c[i] * sgn * kSqrt2, -1.0f, 1.0f); // [-1/√2, 1/√2] -> [-1, 1]
+		const uint32_t u = (uint32_t)std::lround((s * 0.5f + 0.5f) * kQ15);
+		bits |= (uint64_t)u << shift;
+		shift -= 15;
+	}
+
+	AnimQuat48 p;
+	p.v[0] = (uint16_t)(bits & 0xFFFF);
+	p.v[1] = (uint16_t)((bits >> 16) & 0xFFFF);
+	p.v[2] = (uint16_t)((bits >> 32) & 0xFFFF);
+	return p;
+}
+
+static XMVECTOR UnpackQuat(const AnimQuat48& p)
+{
+	const uint64_t bits = (uint64_t)p.v[0] | ((uint64_t)p.v[1] << 16) | ((uint64_t)p.v[2] << 32);
+	const int big = (int)((bits >> 45) & 3);
+
+	float c[4];
+	float sum = 0.0f;
+	int shift = 30;
+	for (int i = 0; i < 4; ++i) {
+		if (i == big) continue;
+		const uint32_t u = (uint32_t)((bits >> shift) & 0x7FFF);
+		shift -= 15;
+		c[i] = ((float)u / kQ15 * 2.0f - 1.0f) * kInvSqrt2;
+		sum += c[i] * c[i];
+	}
+	c[big] = std::sqrt(std::max(0.0f, 1.0f - sum));
+	return XMVectorSet(c[0], c[1], c[2], c[3]);
+}
+
+static AnimVec48 PackPos(const XMFLOAT3& v, const XMFLOAT3& mn, const XMFLOAT3& step)
+{
+	auto q = [](float x, float m, float s) -> uint16_t {
+		if (s <= 0.0f) return 0;
+		return (uint16_t)std::clamp(std::lround((x - m) / s), 0L, (long)kQ16);
+		};
+	return { { q(v.x, mn.x, step.x), q(v.y, mn.y, step.y), q(v.z, mn.z, step.z) } };
+}
+
+static XMVECTOR UnpackPos(const AnimVec48& p, FXMVECTOR mn, FXMVECTOR step)
+{
+	const XMVECTOR q = XMVectorSet((float)p.v[0], (float)p.v[1], (float)p.v[2], 0.0f);
+	return XMVectorMultiplyAdd(q, step, mn);
+}
+
+// ===== 키 제거 =====
+// a에서 시작해 b를 한 칸씩 늘리며, a..b 직선 보간이 사이 키를 모두 tol 안에서
+// 덮지 못하게 되는 순간 b-1을 남긴다. 남는 키 인덱스(오름차순)를 돌려준다.
+template<class V, class Lerp, class Err>
+static std::vector<uint32_t> ReduceKeys(const std::vector<float>& t, const std::vector<V>& v,
+	float tol, Lerp lerp, Err err)
+{
+	const uint32_t n = (uint32_t)v.size();
+	std::vector<uint32_t> kept;
+	kept.push_back(0);
+	if (n <= 1) return kept;
+
+	// 상수 트랙이면 키 하나로
+	bool flat = true;
+	for (uint32_t i = 1; i < n && flat; ++i) flat = err(v[0], v[i]) <= tol;
+	if (flat) return kept;
+
+	uint32_t a = 0;
+	for (uint32_t b = 2; b < n; ++b) {
+		const float len = t[b] - t[a];
+		bool ok = true;
+		for (uint32_t i = a + 1; i < b && ok; ++i) {
+			const float u = (len > 0.0f) ? (t[i] - t[a]) / len : 0.0f;
+			ok = err(lerp(v[a], v[b], u), v[i]) <= tol;
+		}
+		if (!ok) { kept.push_back(b - 1); a = b - 1; }
+	}
+	kept.push_back(n - 1);
+	return kept;
+}
+
+static float DistV3(const XMFLOAT3& a, const XMFLOAT3& b)
+{
+	return XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&a), XMLoadFloat3(&b))));
+}
+
+// 두 회전 사이 각도(도). acos(dot)는 1 근처에서 float 오차가 커서 현 길이로 잰다.
+static float AngleDeg(FXMVECTOR a, FXMVECTOR b)
+{
+	const bool flip = XMVectorGetX(XMVector4Dot(a, b)) < 0.0f;
+	const XMVECTOR d = XMVectorSubtract(a, flip ? XMVectorNegate(b) : b);
+	const float chord = XMVectorGetX(XMVector4Length(d));
+	return XMConvertToDegrees(4.0f * std::asin(std::min(1.0f, chord * 0.5f)));
+}
+
+static XMFLOAT3 LerpV3(const XMFLOAT3& a, const XMFLOAT3& b, float u)
+{
+	XMFLOAT3 r;
+	XMStoreFloat3(&r, XMVectorLerp(XMLoadFloat3(&a), XMLoadFloat3(&b), u));
+	return r;
+}
+
+// ===== 배치 회전 보간 =====
+// 쿼터니언 4쌍을 SoA(x4/y4/z4/w4)로 돌려 한 번에:
+//  dot -> 음수면 b 부호 반전(짧은 호) -> a + (b - a) * u -> 정규화.
+// |dot| < cosHalfMax (회전각이 임계 초과)인 레인만 slerp로 덮어쓴다. 인접 키 사이는 거의 항상 nlerp.
+struct QuatBatch4
+{
+	XMVECTOR a[4], b[4];
+	float u[4];
+	XMFLOAT4A* dst[4];
+	int n = 0;
+};
+
+static void FlushQuatBatch(QuatBatch4& q, float cosHalfMax)
+{
+	if (q.n == 0) return;
+	for (int k = q.n; k < 4; ++k) { q.a[k] = q.b[k] = XMQuaternionIdentity(); q.u[k] = 0.0f; }
+
+	const XMMATRIX A = XMMatrixTranspose(XMMATRIX(q.a[0], q.a[1], q.a[2], q.a[3]));
+	XMMATRIX B = XMMatrixTranspose(XMMATRIX(q.b[0], q.b[1], q.b[2], q.b[3]));
+	const XMVECTOR u = XMVectorSet(q.u[0], q.u[1], q.u[2], q.u[3]);
+
+	XMVECTOR dot = XMVectorMultiply(A.r[0], B.r[0]);
+	dot = XMVectorMultiplyAdd(A.r[1], B.r[1], dot);
+	dot = XMVectorMultiplyAdd(A.r[2], B.r[2], dot);
+	dot = XMVectorMultiplyAdd(A.r[3], B.r[3], dot);
+
+	const XMVECTOR flip = XMVectorLess(dot, XMVectorZero());
+	for (int c = 0; c < 4; ++c) B.r[c] = XMVectorSelect(B.r[c], XMVectorNegate(B.r[c]), flip);
+
+	XMMATRIX R;
+	XMVECTOR len2 = XMVectorZero();
+	for (int c = 0; c < 4; ++c) {
+		R.r[c] = XMVectorMultiplyAdd(XMVectorSubtract(B.r[c], A.r[c]), u, A.r[c]);
+		len2 = XMVectorMultiplyAdd(R.r[c], R.r[c], len2);
+	}
+	const XMVECTOR inv = XMVectorReciprocalSqrt(len2);
+	for (int c = 0; c < 4; ++c) R.r[c] = XMVectorMultiply(R.r[c], inv);
+	R = XMMatrixTranspose(R);
+
+	XMUINT4 slow;
+	XMStoreUInt4(&slow, XMVectorLess(XMVectorAbs(dot), XMVectorReplicate(cosHalfMax)));
+	const uint32_t* sl = &slow.x;
+	for (int k = 0; k < q.n; ++k) {
+		const XMVECTOR r = sl[k] ? XMQuaternionSlerp(q.a[k], q.b[k], q.u[k]) : R.r[k];
+		XMStoreFloat4A(q.dst[k], r);
+	}
+	q.n = 0;
+}
+
+static const float kCosHalfNlerpMax = std::cos(XMConvertToRadians(AnimClip::kNlerpMaxDeg) * 0.5f);
+
+// 키 제거용 회전 보간: 런타임(SampleLocalPose) 배치 경로를 레인 하나로 그대로 탄다.
+// 판정 보간이 재생 보간과 같아야 허용 오차가 실제 재생 오차가 된다.
+static XMFLOAT4 LerpQRuntime(const XMFLOAT4& x, const XMFLOAT4& y, float u)
+{
+	XMFLOAT4A r;
+	QuatBatch4 qb;
+	qb.a[0] = XMLoadFloat4(&x);
+	qb.b[0] = XMLoadFloat4(&y);
+	qb.u[0] = u;
+	qb.dst[0] = &r;
+	qb.n = 1;
+	FlushQuatBatch(qb, kCosHalfNlerpMax);
+	return { r.x, r.y, r.z, r.w };
+}
+
+// ===== 본별 허용 오차 =====
+AnimTolerance AnimCompressSettings::ToleranceFor(const std::string& bone, int height) const
+{
+	float k = 1.0f / (1.0f + std::max(0.0f, depthScale) * (float)std::max(0, height));
+	for (const auto& bs : boneScale) {
+		if (bs.first == bone) { k *= bs.second; break; }
+	}
+	return { posTol * k, rotTolDeg * k, scaleTol * k };
+}
+
+// ===== 균일 리샘플 =====
+// 원본 (t, v) 키를 0, 1/keyRate, 2/keyRate ... 에서 다시 샘플해 t/v를 덮어쓴다.
+// 상수 트랙이면 키 1개. kept는 새 키 전부 (키 제거 안 함).
+template<class V, class Lerp, class Err>
+static void ResampleUniform(std::vector<float>& t, std::vector<V>& v, uint32_t n,
+	float keyRate, float tol, Lerp lerp, Err err, std::vector<uint32_t>& kept)
+{
+	bool flat = true;
+	for (size_t i = 1; i < v.size() && flat; ++i) flat = err(v[0], v[i]) <= tol;
+
+	std::vector<float> nt;
+	std::vector<V> nv;
+	if (flat || n <= 1) {
+		nt.push_back(0.0f);
+		nv.push_back(v[0]);
+	}
+	else {
+		nt.resize(n);
+		nv.resize(n);
+		for (uint32_t k = 0; k < n; ++k) {
+			const float tk = (float)k / keyRate;
+			const size_t ub = std::upper_bound(t.begin(), t.end(), tk) - t.begin();
+			if (ub == 0) nv[k] = v.front();
+			else if (ub >= t.size()) nv[k] = v.back();
+			else {
+				const float len = t[ub] - t[ub - 1];
+				nv[k] = lerp(v[ub - 1], v[ub], (len > 0.0f) ? (tk - t[ub - 1]) / len : 0.0f);
+			}
+			nt[k] = tk;
+		}
+	}
+
+	// 오차 측정은 원본 키 기준이라 원본은 살려 두고, 새 키는 뒤에 붙여 kept로 가리킨다
+	kept.clear();
+	const uint32_t base = (uint32_t)t.size();
+	t.insert(t.end(), nt.begin(), nt.end());
+	v.insert(v.end(), nv.begin(), nv.end());
+	for (uint32_t k = 0; k < (uint32_t)nt.size(); ++k) kept.push_back(base + k);
+}
+
+// ===== 로드 =====
+AnimClip AnimClip::FromAssimp(const aiAnimation* a,
+	const std::unordered_map<std::string, int>& nameToNode,
+	size_t nodeCount,
+	const AnimCompressSettings& cs,
+	const int* parents)
+{
+	AnimClip clip;
+	clip.nodeChannel.assign(nodeCount, -1);
+	if (!a) return clip;
+
+	// 본별 허용 오차용 서브트리 높이 (부모 < 자식이라 뒤에서부터 한 번에). parents 없으면 전부 0
+	std::vector<int> height(nodeCount, 0);
+	if (parents) {
+		for (size_t i = nodeCount; i-- > 0;) {
+			const int pi = parents[i];
+			if (pi >= 0 && (size_t)pi < nodeCount) height[pi] = std::max(height[pi], height[i] + 1);
+		}
+	}
+
+	clip.name = a->mName.C_Str();
+	clip.duration = a->mDuration;
+	clip.ticksPerSec = (a->mTicksPerSecond > 0.0) ? a->mTicksPerSecond : 25.0;
+
+	// 균일 리샘플: 키/tick과 트랙당 키 수 (양 끝 포함)
+	// ticksPerSec가 아주 큰 FBX(ms 단위 등)에서 키가 폭증하지 않게, 원본 최대 키 수의 4배로 자른다.
+	uint32_t uniformKeys = 0;
+	if (cs.resampleRate != 0.0f && clip.duration > 0.0) {
+		const double perSec = (cs.resampleRate < 0.0f) ? clip.ticksPerSec : (double)cs.resampleRate;
+		uint32_t maxRaw = 2;
+		for (unsigned c = 0; c < a->mNumChannels; ++c) {
+			const aiNodeAnim* na = a->mChannels[c];
+			maxRaw = std::max({ maxRaw, na->mNumPositionKeys, na->mNumRotationKeys, na->mNumScalingKeys });
+		}
+		const double want = std::ceil(clip.duration * perSec / clip.ticksPerSec) + 1.0;
+		uniformKeys = (uint32_t)std::clamp(want, 2.0, 4.0 * maxRaw + 1.0);
+		clip.keyRate = (float)((uniformKeys - 1) / clip.duration);
+	}
+
+	// --- 1) 원본 키 수집 + 키 제거 ---
+	struct RawTrack
+	{
+		std::vector<float> t;
+		std::vector<XMFLOAT3> v3;
+		std::vector<XMFLOAT4> q;
+		std::vector<uint32_t> kept;
+	};
+	struct RawChannel { RawTrack T, R, S; };
+	std::vector<RawChannel> raw(a->mNumChannels);
+
+	// 리샘플 값 생성은 원본을 정확히 (slerp), 키 제거 판정은 런타임 보간으로
+	auto lerpQ = [](const XMFLOAT4& x, const XMFLOAT4& y, float u) {
+		XMFLOAT4 r;
+		XMStoreFloat4(&r, XMQuaternionSlerp(XMLoadFloat4(&x), XMLoadFloat4(&y), u));
+		return r;
+		};
+	auto errQ = [](const XMFLOAT4& x, const XMFLOAT4& y) {
+		return AngleDeg(XMLoadFloat4(&x), XMLoadFloat4(&y));
+		};
+
+	XMVECTOR pMin = XMVectorReplicate(FLT_MAX);
+	XMVECTOR pMax = XMVectorReplicate(-FLT_MAX);
+	bool anyPos = false;
+
+	for (unsigned c = 0; c < a->mNumChannels; ++c) {
+		const aiNodeAnim* na = a->mChannels[c];
+		RawChannel& rc = raw[c];
+
+		const std::string target = na->mNodeName.C_Str();
+		const auto itNode = nameToNode.find(target);
+		const int h = (itNode != nameToNode.end() && (size_t)itNode->second < nodeCount) ? height[itNode->second] : 0;
+		const AnimTolerance tol = cs.ToleranceFor(target, h);
+
+		for (unsigned k = 0; k < na->mNumPositionKeys; ++k) {
+			const aiVectorKey& key = na->mPositionKeys[k];
+			rc.T.t.push_back((float)key.mTime);
+			rc.T.v3.push_back({ key.mValue.x, key.mValue.y, key.mValue.z });
+		}
+		for (unsigned k = 0; k < na->mNumRotationKeys; ++k) {
+			const aiQuatKey& key = na->mRotationKeys[k];
+			XMFLOAT4 q;
+			XMStoreFloat4(&q, XMQuaternionNormalize(XMVectorSet(key.mValue.x, key.mValue.y, key.mValue.z, key.mValue.w)));
+			rc.R.t.push_back((float)key.mTime);
+			rc.R.q.push_back(q);
+		}
+		for (unsigned k = 0; k < na->mNumScalingKeys; ++k) {
+			const aiVectorKey& key = na->mScalingKeys[k];
+			rc.S.t.push_back((float)key.mTime);
+			rc.S.v3.push_back({ key.mValue.x, key.mValue.y, key.mValue.z });
+		}
+
+		if (uniformKeys) {
+			if (!rc.T.t.empty()) ResampleUniform(rc.T.t, rc.T.v3, uniformKeys, clip.keyRate, tol.pos, LerpV3, DistV3, rc.T.kept);
+			if (!rc.R.t.empty()) ResampleUniform(rc.R.t, rc.R.q, uniformKeys, clip.keyRate, tol.rotDeg, lerpQ, errQ, rc.R.kept);
+			if (!rc.S.t.empty()) ResampleUniform(rc.S.t, rc.S.v3, uniformKeys, clip.keyRate, tol.scale, LerpV3, DistV3, rc.S.kept);
+		}
+		else {
+			if (!rc.T.t.empty()) rc.T.kept = ReduceKeys(rc.T.t, rc.T.v3, tol.pos, LerpV3, DistV3);
+			if (!rc.R.t.empty()) rc.R.kept = ReduceKeys(rc.R.t, rc.R.q, tol.rotDeg, LerpQRuntime, errQ);
+			if (!rc.S.t.empty()) rc.S.kept = ReduceKeys(rc.S.t, rc.S.v3, tol.scale, LerpV3, DistV3);
+		}
+
+		for (uint32_t k : rc.T.kept) {
+			const XMVECTOR p = XMLoadFloat3(&rc.T.v3[k]);
+			pMin = XMVectorMin(pMin, p);
+			pMax = XMVectorMax(pMax, p);
+			anyPos = true;
+		}
+
+		clip.stats.rawKeys += na->mNumPositionKeys + na->mNumRotationKeys + na->mNumScalingKeys;
+		clip.stats.keptKeys += (uint32_t)(rc.T.kept.size() + rc.R.kept.size() + rc.S.kept.size());
+		clip.stats.rawBytes += na->mNumPositionKeys * sizeof(aiVectorKey)
+			+ na->mNumRotationKeys * sizeof(aiQuatKey)
+			+ na->mNumScalingKeys * sizeof(aiVectorKey);
+	}
+
+	// 이동 양자화 범위 (클립 단위)
+	if (anyPos) {
+		XMStoreFloat3(&clip.posMin, pMin);
+		XMStoreFloat3(&clip.posStep, XMVectorScale(XMVectorSubtract(pMax, pMin), 1.0f / kQ16));
+	}
+
+	// --- 2) 패킹 ---
+	// 같은 시간열은 한 번만 저장
+	std::map<std::vector<float>, uint32_t> timePool;
+	auto internTimes = [&](const RawTrack& rt) -> uint32_t {
+		if (clip.keyRate > 0.0f) return 0; // 균일: 시간열 없음
+
+		std::vector<float> ts;
+		ts.reserve(rt.kept.size());
+		for (uint32_t k : rt.kept) ts.push_back(rt.t[k]);
+
+		auto it = timePool.find(ts);
+		if (it != timePool.end()) return it->second;
+
+		const uint32_t ofs = (uint32_t)clip.times.size();
+		clip.times.insert(clip.times.end(), ts.begin(), ts.end());
+		timePool.emplace(std::move(ts), ofs);
+		return ofs;
+		};
+
+	clip.channels.reserve(a->mNumChannels);
+	for (unsigned c = 0; c < a->mNumChannels; ++c) {
+		const RawChannel& rc = raw[c];
+		AnimChannel ch;
+		ch.target = a->mChannels[c]->mNodeName.C_Str();
+
+		if (!rc.T.kept.empty()) {
+			ch.T.count = (uint32_t)rc.T.kept.size();
+			ch.T.timeOffset = internTimes(rc.T);
+			ch.T.valueOffset = (uint32_t)clip.poss.size();
+			for (uint32_t k : rc.T.kept) clip.poss.push_back(PackPos(rc.T.v3[k], clip.posMin, clip.posStep));
+		}
+		if (!rc.R.kept.empty()) {
+			ch.R.count = (uint32_t)rc.R.kept.size();
+			ch.R.timeOffset = internTimes(rc.R);
+			ch.R.valueOffset = (uint32_t)clip.rots.size();
+			for (uint32_t k : rc.R.kept) clip.rots.push_back(PackQuat(rc.R.q[k]));
+		}
+		if (!rc.S.kept.empty()) {
+			ch.S.count = (uint32_t)rc.S.kept.size();
+			ch.S.timeOffset = internTimes(rc.S);
+			ch.S.valueOffset = (uint32_t)clip.scales.size();
+			for (uint32_t k : rc.S.kept) clip.scales.push_back(rc.S.v3[k]);
+		}
+
+		// 노드 -> 채널 테이블 (평가 때 이름 해싱 없이 인덱스로 접근)
+		auto itNode = nameToNode.find(ch.target);
+		if (itNode != nameToNode.end())
+			clip.nodeChannel[itNode->second] = (int)clip.channels.size();
+
+		clip.channels.push_back(std::move(ch));
+	}
+	clip.times.shrink_to_fit();
+
+	// --- 3) 오차 측정: 원본 키 시각마다 압축 트랙을 런타임과 같은 경로로 샘플해 비교 ---
+	// R은 SampleLocalPose와 같은 배치(FlushQuatBatch)로. T/S는 SampleT/SampleS 그대로.
+	std::vector<XMFLOAT4A> rq;
+	for (size_t c = 0; c < clip.channels.size(); ++c) {
+		const AnimChannel& ch = clip.channels[c];
+		const RawChannel& rc = raw[c];
+		AnimCursor cur;
+
+		const size_t nR = a->mChannels[c]->mNumRotationKeys;
+		rq.resize(nR);
+		if (ch.R.count > 0) {
+			const AnimQuat48* qs = clip.rots.data() + ch.R.valueOffset;
+			QuatBatch4 qb;
+			for (size_t k = 0; k < nR; ++k) {
+				int i0, i1; float u;
+				clip.KeySpan(ch.R, rc.R.t[k], cur.r, i0, i1, u);
+				if (i0 == i1) { XMStoreFloat4A(&rq[k], UnpackQuat(qs[i0])); continue; }
+				qb.a[qb.n] = UnpackQuat(qs[i0]);
+				qb.b[qb.n] = UnpackQuat(qs[i1]);
+				qb.u[qb.n] = u;
+				qb.dst[qb.n] = &rq[k];
+				if (++qb.n == 4) FlushQuatBatch(qb, kCosHalfNlerpMax);
+			}
+			FlushQuatBatch(qb, kCosHalfNlerpMax);
+		}
+
+		for (size_t k = 0; k < a->mChannels[c]->mNumPositionKeys; ++k) {
+			const XMVECTOR d = XMVectorSubtract(clip.SampleT(ch.T, rc.T.t[k], cur.t), XMLoadFloat3(&rc.T.v3[k]));
+			clip.stats.maxErrT = std::max(clip.stats.maxErrT, XMVectorGetX(XMVector3Length(d)));
+		}
+		for (size_t k = 0; k < nR && ch.R.count > 0; ++k) {
+			const float e = AngleDeg(XMLoadFloat4A(&rq[k]), XMLoadFloat4(&rc.R.q[k]));
+			clip.stats.maxErrRDeg = std::max(clip.stats.maxErrRDeg, e);
+		}
+		for (size_t k = 0; k < a->mChannels[c]->mNumScalingKeys; ++k) {
+			const XMVECTOR d = XMVectorSubtract(clip.SampleS(ch.S, rc.S.t[k], cur.s), XMLoadFloat3(&rc.S.v3[k]));
+			clip.stats.maxErrS = std::max(clip.stats.maxErrS, XMVectorGetX(XMVector3Length(d)));
+		}
+	}
+	clip.stats.packedBytes = clip.MemoryBytes();
+
+	LOG_MESSAGEA("AnimClip '%.40s'%s: keys %u -> %u, x%.2f, err T %.5f R %.4fdeg S %.5f",
+		clip.name.c_str(), (clip.keyRate > 0.0f) ? " (uniform)" : "",
+		clip.stats.rawKeys, clip.stats.keptKeys, clip.stats.Ratio(),
+		clip.stats.maxErrT, clip.stats.maxErrRDeg, clip.stats.maxErrS);
+	return clip;
+}
+
+// ===== 샘플링 =====
+void AnimClip::KeySpan(const AnimTrack& tr, float tTick, int& cursor, int& i0, int& i1, float& u) const
+{
+	const int n = (int)tr.count;
+	u = 0.0f;
+	if (n == 1) { i0 = i1 = 0; return; }
+
+	if (keyRate > 0.0f) {
+		i0 = UniformKey(tTick, keyRate, n, u);
+		i1 = i0 + 1;
+		return;
+	}
+
+	const float* ts = times.data() + tr.timeOffset;
+	const int ub = UpperBoundCursor(ts, n, tTick, cursor);
+	if (ub <= 0) { i0 = i1 = 0; return; }
+	if (ub >= n) { i0 = i1 = n - 1; return; }
+
+	i0 = ub - 1;
+	i1 = ub;
+	const float len = ts[i1] - ts[i0];
+	u = (len > 0.0f) ? (tTick - ts[i0]) / len : 0.0f;
+}
+
+XMVECTOR AnimClip::SampleT(const AnimTrack& tr, float tTick, int& cursor) const
+{
+	const AnimVec48* vs = poss.data() + tr.valueOffset;
+	const XMVECTOR mn = XMLoadFloat3(&posMin);
+	const XMVECTOR st = XMLoadFloat3(&posStep);
+
+	int i0, i1; float u;
+	KeySpan(tr, tTick, cursor, i0, i1, u);
+	if (i0 == i1) return UnpackPos(vs[i0], mn, st);
+	return XMVectorLerp(UnpackPos(vs[i0], mn, st), UnpackPos(vs[i1], mn, st), u);
+}
+
+XMVECTOR AnimClip::SampleR(const AnimTrack& tr, float tTick, int& cursor) const
+{
+	const AnimQuat48* qs = rots.data() + tr.valueOffset;
+
+	int i0, i1; float u;
+	KeySpan(tr, tTick, cursor, i0, i1, u);
+	if (i0 == i1) return UnpackQuat(qs[i0]);
+	return XMQuaternionSlerp(UnpackQuat(qs[i0]), UnpackQuat(qs[i1]), u);
+}
+
+XMVECTOR AnimClip::SampleS(const AnimTrack& tr, float tTick, int& cursor) const
+{
+	const XMFLOAT3* vs = scales.data() + tr.valueOffset;
+
+	int i0, i1; float u;
+	KeySpan(tr, tTick, cursor, i0, i1, u);
+	if (i0 == i1) return XMLoadFloat3(&vs[i0]);
+	return XMVectorLerp(XMLoadFloat3(&vs[i0]), XMLoadFloat3(&vs[i1]), u);
+}
+
+void AnimClip::SampleLocalPose(float tTick, AnimCursor* cursors,
+	const PoseMath::PoseTRS* bind, bool bindTWhenMissing,
+	PoseMath::PoseTRS* out, float slerpAboveDeg) const
+{
+	// 회전각 θ 기준 임계 -> 쿼터니언 내적(= cos(θ/2)) 기준
+	const float cosHalfMax = std::cos(XMConvertToRadians(slerpAboveDeg) * 0.5f);
+
+	QuatBatch4 qb;
+	const size_t nodeCount = nodeChannel.size();
+	for (size_t i = 0; i < nodeCount; ++i) {
+		PoseMath::PoseTRS& p = out[i];
+		const int ci = nodeChannel[i];
+		if (ci < 0) { p = bind[i]; continue; }
+
+		const AnimChannel& ch = channels[ci];
+		AnimCursor& cur = cursors[ci];
+
+		p = PoseMath::PoseTRS{};
+		if (bindTWhenMissing) p.t = bind[i].t;
+		if (ch.T.count > 0) XMStoreFloat3(&p.t, SampleT(ch.T, tTick, cur.t));
+		if (ch.S.count > 0) XMStoreFloat3(&p.s, SampleS(ch.S, tTick, cur.s));
+		if (ch.R.count == 0) continue;
+
+		const AnimQuat48* qs = rots.data() + ch.R.valueOffset;
+		int i0, i1; float u;
+		KeySpan(ch.R, tTick, cur.r, i0, i1, u);
+		if (i0 == i1) { XMStoreFloat4A(&p.r, UnpackQuat(qs[i0])); continue; }
+
+		qb.a[qb.n] = UnpackQuat(qs[i0]);
+		qb.b[qb.n] = UnpackQuat(qs[i1]);
+		qb.u[qb.n] = u;
+		qb.dst[qb.n] = &p.r;
+		if (++qb.n == 4) FlushQuatBatch(qb, cosHalfMax);
+	}
+	FlushQuatBatch(qb, cosHalfMax);
+}
+
+void AnimClip::SampleLocalPoseRef(float tTick, AnimCursor* cursors,
+	const PoseMath::PoseTRS* bind, bool bindTWhenMissing,
+	PoseMath::PoseTRS* out) const
+{
+	const size_t nodeCount = nodeChannel.size();
+	for (size_t i = 0; i < nodeCount; ++i) {
+		PoseMath::PoseTRS& p = out[i];
+		const int ci = nodeChannel[i];
+		if (ci < 0) { p = bind[i]; continue; }
+
+		const AnimChannel& ch = channels[ci];
+		AnimCursor& cur = cursors[ci];
+
+		p = PoseMath::PoseTRS{};
+		if (bindTWhenMissing) p.t = bind[i].t;
+		if (ch.T.count > 0) XMStoreFloat3(&p.t, SampleT(ch.T, tTick, cur.t));
+		if (ch.R.count > 0) XMStoreFloat4A(&p.r, SampleR(ch.R, tTick, cur.r));
+		if (ch.S.count > 0) XMStoreFloat3(&p.s, SampleS(ch.S, tTick, cur.s));
+	}
+}
+
+size_t AnimClip::MemoryBytes() const
+{
+	return times.size() * sizeof(float)
+		+ rots.size() * sizeof(AnimQuat48)
+		+ poss.size() * sizeof(AnimVec48)
+		+ scales.size() * sizeof(XMFLOAT3)
+		+ channels.size() * sizeof(AnimChannel)
+		+ nodeChannel.size() * sizeof(int);
+}
+
+// ===== 클립 라이브러리 =====
+std::shared_ptr<const AnimClipLibrary> AnimClipLibrary::FromAssimp(const aiScene* sc,
+	const std::unordered_map<std::string, int>& nameToNode,
+	size_t nodeCount,
+	const AnimCompressSettings& cs,
+	const int* parents)
+{
+	std::vector<AnimClip> clips;
+	if (sc) {
+		clips.reserve(sc->mNumAnimations);
+		for (unsigned i = 0; i < sc->mNumAnimations; ++i)
+			clips.push_back(AnimClip::FromAssimp(sc->mAnimations[i], nameToNode, nodeCount, cs, parents));
+	}
+	return FromClips(std::move(clips));
+}
+
+std::shared_ptr<const AnimClipLibrary> AnimClipLibrary::FromClips(std::vector<AnimClip>&& clips)
+{
+	auto lib = std::make_shared<AnimClipLibrary>();
+	lib->mClips.reserve(clips.size());
+	for (size_t i = 0; i < clips.size(); ++i) {
+		AnimClip& clip = clips[i];
+		if (clip.name.empty()) clip.name = "Clip" + std::to_string(i);
+
+		// 이름이 겹치면 먼저 나온 클립이 이름 조회를 가진다 (인덱스로는 둘 다 접근 가능)
+		lib->mByName.emplace(clip.name, (int)lib->mClips.size());
+		lib->mClips.push_back(std::make_shared<const AnimClip>(std::move(clip)));
+	}
+	return lib;
+}
+
+int AnimClipLibrary::IndexOf(const std::string& name) const
+{
+	auto it = mByName.find(name);
+	return (it != mByName.end()) ? it->second : -1;
+}
+
+std::shared_ptr<const AnimClip> AnimClipLibrary::Find(const std::string& name) const
+{
+	const int i = IndexOf(name);
+	return (i >= 0) ? mClips[i] : nullptr;
+}
+
+std::vector<uint8_t> AnimClipLibrary::AnimatedMask(size_t nodeCount) const
+{
+	std::vector<uint8_t> mask(nodeCount, 0);
+	for (const auto& c : mClips) {
+		const size_t n = std::min(nodeCount, c->nodeChannel.size());
+		for (size_t i = 0; i < n; ++i)
+			if (c->nodeChannel[i] >= 0) mask[i] = 1;
+	}
+	return mask;
+}
+
+size_t AnimClipLibrary::MemoryBytes() const
+{
+	size_t bytes = 0;
+	for (const auto& c : mClips) bytes += c->MemoryBytes();
+	return bytes;
+}
@@ -0,0 +1,184 @@
+﻿// AnimClip.h
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <utility>
+#include <DirectXMath.h>
+
+#include "PoseMath.h"
+
+struct aiAnimation;
+struct aiScene;
+
+//================================================================================================
+// 애니메이션 클립 (SoA 패킹 + 압축) — RigidSkeletal / SkinnedSkeletal 공용
+//  - 키 시간은 float(ticks)로 클립 전체에 한 배열. 트랙은 (offset, count)로 구간만 가리킨다.
+//    같은 시간열(T/R/S 키가 같은 프레임에 찍힌 경우 등)은 한 번만 저장하고 공유.
+//  - 로드 시 압축:
+//    1) 런타임과 같은 보간(R은 nlerp, 큰 각만 slerp)으로 허용 오차 안에서 복원되는 키는 버린다
+//       허용 오차는 본 단위 (계층 높이/이름 배율, AnimCompressSettings::ToleranceFor)
+//    2) 회전: smallest-three 48bit (가장 큰 성분 인덱스 2bit + 나머지 3성분 15bit)
+//    3) 이동: 클립 전체 이동 범위(min/extent) 기준 16bit x3
+//    4) 스케일: 키 제거만 (대부분 1~2키로 줄어든다)
+//  - 선택: 균일 리샘플 (AnimCompressSettings::resampleRate)
+//    트랙을 고정 간격 키로 다시 찍어 시간열을 아예 버린다. 키 인덱스 = floor(t * keyRate), 탐색 없음.
+//    상수 트랙은 키 1개로 접는다. 이 모드에선 키 제거(1)는 하지 않는다. (2)(3) 양자화는 그대로.
+//================================================================================================
+
+struct AnimTrack
+{
+    uint32_t timeOffset = 0;  // AnimClip::times 안의 시작 위치
+    uint32_t valueOffset = 0; // AnimClip::rots / poss / scales 안의 시작 위치
+    uint32_t count = 0;       // 키 개수 (0 = 트랙 없음)
+};
+
+struct AnimChannel
+{
+    std::string target;       // 노드 이름 (로드/디버그용)
+    AnimTrack T, R, S;
+};
+
+// 채널별 키 커서: 직전 샘플의 upper bound (인스턴스마다 따로 가진다)
+struct AnimCursor { int t = 0, r = 0, s = 0; };
+
+struct AnimQuat48 { uint16_t v[3]; };  // smallest-three 회전
+struct AnimVec48 { uint16_t v[3]; };  // 클립 범위 기준 양자화 이동
+
+// 본 하나에 실제로 적용되는 허용 오차
+struct AnimTolerance
+{
+    float pos = 0.0f;
+    float rotDeg = 0.0f;
+    float scale = 0.0f;
+};
+
+// 키 제거 허용 오차 (본 로컬 공간 기준)
+//  본마다 실제 허용치 = 기본값 x 계층 배율 x 이름 배율 (ToleranceFor)
+struct AnimCompressSettings
+{
+    float posTol = 0.001f;    // 이동 (모델 단위)
+    float rotTolDeg = 0.05f;  // 회전 (도)
+    float scaleTol = 0.0001f; // 스케일
+
+    // 계층 배율: 아래로 달린 체인 높이가 h인 본은 1 / (1 + depthScale * h).
+    // 루트/척추의 로컬 오차는 말단까지 누적되므로 위쪽 본일수록 빡빡하게. 0 = 모든 본 같은 허용치
+    float depthScale = 0.1f;
+
+    // 이름별 추가 배율 (노드 이름 정확히 일치). 예: 얼굴 본 0.5, 손가락 2
+    std::vector<std::pair<std::string, float>> boneScale;
+
+    // 균일 리샘플 (키/초). 0 = 끔(키 제거 + 시간열 탐색), < 0 = 클립의 ticksPerSec 그대로
+    float resampleRate = 0.0f;
+
+    // height = 노드 아래 가장 긴 체인 길이 (말단 0)
+    AnimTolerance ToleranceFor(const std::string& bone, int height) const;
+};
+
+// 압축 결과 리포트 (오차는 원본 키 시각에서 런타임 샘플러(R은 배치 nlerp)로 재샘플해 잰 실제 최대값)
+struct AnimCompressStats
+{
+    uint32_t rawKeys = 0, keptKeys = 0;
+    size_t rawBytes = 0;      // Assimp 키 배열 기준 (double 시간 + float 값)
+    size_t packedBytes = 0;   // MemoryBytes()
+    float maxErrT = 0.0f;
+    float maxErrRDeg = 0.0f;
+    float maxErrS = 0.0f;
+
+    double Ratio() const { return packedBytes ? double(rawBytes) / double(packedBytes) : 0.0; }
+};
+
+struct AnimClip
+{
+    std::string name;
+    double duration = 0.0;       // ticks
+    double ticksPerSec = 25.0;
+
+    std::vector<AnimChannel> channels;
+    std::vector<int> nodeChannel;            // 노드 인덱스 -> 채널 인덱스 (-1 = 채널 없음)
+
+    std::vector<float>             times;    // 모든 트랙의 키 시간(ticks)
+    std::vector<AnimQuat48>        rots;     // R 키
+    std::vector<AnimVec48>         poss;     // T 키
+    std::vector<DirectX::XMFLOAT3> scales;   // S 키
+
+    DirectX::XMFLOAT3 posMin{ 0, 0, 0 };     // T 역양자화: posMin + q * posStep
+    DirectX::XMFLOAT3 posStep{ 0, 0, 0 };
+
+    // 균일 리샘플된 클립이면 키/tick (> 0). 이때 times는 비어 있고 트랙 k번째 키 시각 = k / keyRate.
+    float keyRate = 0.0f;
+
+    AnimCompressStats stats;
+
+    // aiAnimation -> 압축 클립. nameToNode로 nodeChannel까지 채운다.
+    //  parents: 노드 부모 인덱스 (nodeCount개, 부모 < 자식). 있으면 계층 배율 허용 오차를 쓴다.
+    static AnimClip FromAssimp(const aiAnimation* a,
+        const std::unordered_map<std::string, int>& nameToNode,
+        size_t nodeCount,
+        const AnimCompressSettings& cs = {},
+        const int* parents = nullptr);
+
+    // 트랙 샘플링. cursor는 호출 후 새 upper bound로 갱신됨. (균일 클립이면 cursor 안 씀)
+    DirectX::XMVECTOR SampleT(const AnimTrack& tr, float tTick, int& cursor) const;
+    DirectX::XMVECTOR SampleR(const AnimTrack& tr, float tTick, int& cursor) const;
+    DirectX::XMVECTOR SampleS(const AnimTrack& tr, float tTick, int& cursor) const;
+
+    // 노드 전체 로컬 포즈 (배치). R은 4채널씩 SoA로 nlerp(부호 보정 + 정규화)하고,
+    // 두 키 사이 회전각이 slerpAboveDeg를 넘는 레인만 slerp로 다시 계산. T/S는 lerp.
+    //  cursors : 채널별 커서 (channels.size()개)
+    //  bind    : 노드별 바인드 TRS (nodeChannel.size()개). 채널 없는 노드는 그대로 복사.
+    //  bindTWhenMissing : 채널은 있는데 T 키가 없을 때 바인드 이동을 쓸지 (false면 0)
+    static constexpr float kNlerpMaxDeg = 20.0f;
+    void SampleLocalPose(float tTick, AnimCursor* cursors,
+        const PoseMath::PoseTRS* bind, bool bindTWhenMissing,
+        PoseMath::PoseTRS* out, float slerpAboveDeg = kNlerpMaxDeg) const;
+
+    // 기준 구현: 채널 하나씩 SampleT/R/S (R은 항상 slerp). 배치 경로 정확도 비교용
+    void SampleLocalPoseRef(float tTick, AnimCursor* cursors,
+        const PoseMath::PoseTRS* bind, bool bindTWhenMissing,
+        PoseMath::PoseTRS* out) const;
+
+    double DurationSec() const { return duration / ((ticksPerSec > 0.0) ? ticksPerSec : 25.0); }
+    size_t MemoryBytes() const;
+
+private:
+    // 보간할 두 키 [i0, i1]와 계수 u. 범위 밖이거나 키가 하나면 i0 == i1.
+    void KeySpan(const AnimTrack& tr, float tTick, int& cursor, int& i0, int& i1, float& u) const;
+};
+
+//================================================================================================
+// 클립 라이브러리 — FBX 하나의 aiAnimation 전부를 한 번에 로드해 이름으로 찾는다.
+//  - 클립은 불변(shared_ptr<const>). 같은 리그를 쓰는 스켈레톤 인스턴스끼리 그대로 공유하고,
+//    클립 전환은 포인터 교체로 끝난다. (캐시는 ResourceManager::GetOrBuildAnimClips)
+//  - nodeChannel은 로드한 노드 순서 기준이라 같은 노드 순서를 가진 리그끼리만 공유할 것.
+//================================================================================================
+class AnimClipLibrary
+{
+public:
+    static std::shared_ptr<const AnimClipLibrary> FromAssimp(const aiScene* sc,
+        const std::unordered_map<std::string, int>& nameToNode,
+        size_t nodeCount,
+        const AnimCompressSettings& cs = {},
+        const int* parents = nullptr);
+
+    // 이미 만든 클립들로 (쿡 파일 로드). 이름 없는 클립은 "Clip<i>"
+    static std::shared_ptr<const AnimClipLibrary> FromClips(std::vector<AnimClip>&& clips);
+
+    size_t Count() const noexcept { return mClips.size(); }
+    const std::shared_ptr<const AnimClip>& Get(size_t i) const { return mClips[i]; }
+
+    // 없으면 -1 / nullptr
+    int IndexOf(const std::string& name) const;
+    std::shared_ptr<const AnimClip> Find(const std::string& name) const;
+
+    // 노드별로 어떤 클립이든 채널이 있으면 1 (정적 서브트리 판정용)
+    std::vector<uint8_t> AnimatedMask(size_t nodeCount) const;
+
+    size_t MemoryBytes() const;
+
+private:
+    std::vector<std::shared_ptr<const AnimClip>> mClips;
+    std::unordered_map<std::string, int> mByName;
+};
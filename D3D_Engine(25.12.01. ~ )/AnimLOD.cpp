@@ -0,0 +1,86 @@
+﻿// AnimLOD.cpp
+#include "../D3D_Core/pch.h"
+#include "AnimLOD.h"
+
+const char* ToString(AnimRate r)
+{
+	switch (r) {
+	case AnimRate::Full:    return "Full";
+	case AnimRate::Half:    return "1/2";
+	case AnimRate::Quarter: return "1/4";
+	default:                return "Frozen";
+	}
+}
+
+void AnimScheduler::BeginFrame(const Matrix& view, const Matrix& proj, float viewportH)
+{
+	++mFrame;
+	mView = view;
+	BoundingFrustum::CreateFromMatrix(mFrustum, proj);
+	mPxPerUnitAt1 = proj._22 * viewportH * 0.5f;
+}
+
+void AnimScheduler::Classify(AnimLODInstance& inst, const Matrix& world, bool enabled) const
+{
+	if (!enabled) { inst.visible = false; inst.screenPx = 0.0f; inst.rate = AnimRate::Frozen; return; }
+
+	// 바운딩 구 -> 월드 -> 뷰 (반지름은 월드의 최대 축 스케일만큼)
+	const XMMATRIX W = XMLoadFloat4x4(&world);
+	const float sx = XMVectorGetX(XMVector3Length(W.r[0]));
+	const float sy = XMVectorGetX(XMVector3Length(W.r[1]));
+	const float sz = XMVectorGetX(XMVector3Length(W.r[2]));
+	const float r = inst.radius * std::max(sx, std::max(sy, sz));
+	const XMVECTOR cV = XMVector3TransformCoord(
+		XMVector3TransformCoord(XMLoadFloat3(&inst.center), W), XMLoadFloat4x4(&mView));
+
+	BoundingSphere s;
+	XMStoreFloat3(&s.Center, cV);
+	s.Radius = r;
+	inst.visible = mFrustum.Intersects(s);
+
+	const float z = XMVectorGetZ(cV);
+	inst.screenPx = (z > r) ? (2.0f * r * mPxPerUnitAt1 / z) : FLT_MAX; // 카메라가 구 안이면 최대
+
+	if (!settings.enabled)          inst.rate = AnimRate::Full;
+	else if (!inst.visible)         inst.rate = settings.offscreen;
+	else if (inst.screenPx >= settings.fullPx)    inst.rate = AnimRate::Full;
+	else if (inst.screenPx >= settings.halfPx)    inst.rate = AnimRate::Half;
+	else if (inst.screenPx >= settings.quarterPx) inst.rate = AnimRate::Quarter;
+	else                            inst.rate = AnimRate::Frozen;
+}
+
+bool AnimScheduler::ShouldEvaluate(AnimLODInstance& inst, double t) const
+{
+	bool eval;
+	if (inst.force)                      eval = true;
+	else if (t == inst.lastEvalT)        eval = false; // 일시정지: 포즈가 그대로
+	else if (inst.rate == AnimRate::Frozen) eval = false;
+	else eval = ((mFrame + inst.phase) % (uint32_t)inst.rate) == 0;
+
+	if (eval) { inst.force = false; inst.lastEvalT = t; ++inst.evals; }
+	else ++inst.skips;
+	return eval;
+}
+
+void AnimScheduler::UpdateBounds(AnimLODInstance& inst, const Matrix* global, size_t n)
+{
+	if (n == 0) return;
+
+	XMVECTOR mn = XMLoadFloat4x4(&global[0]).r[3], mx = mn;
+	for (size_t i = 1; i < n; ++i) {
+		const XMVECTOR p = XMLoadFloat4x4(&global[i]).r[3];
+		mn = XMVectorMin(mn, p);
+		mx = XMVectorMax(mx, p);
+	}
+	const XMVECTOR c = XMVectorScale(XMVectorAdd(mn, mx), 0.5f);
+	const float halfDiag = XMVectorGetX(XMVector3Length(XMVectorSubtract(mx, c)));
+
+	XMStoreFloat3(&inst.center, c);
+	inst.radius = std::max(halfDiag * 1.25f, 0.1f); // 관절 밖 메쉬 두께 여유
+}
+
+void AnimScheduler::UpdateBounds(AnimLODInstance& inst, const BoundingBox& box)
+{
+	inst.center = box.Center;
+	inst.radius = std::max(XMVectorGetX(XMVector3Length(XMLoadFloat3(&box.Extents))), 0.1f);
+}
@@ -0,0 +1,78 @@
+﻿// AnimLOD.h
+#pragma once
+#include <cstdint>
+#include <DirectXCollision.h>
+#include <directxtk/SimpleMath.h>
+
+//================================================================================================
+// 애니메이션 LOD / 업데이트 주기 스케줄러
+//  - 인스턴스마다 화면 크기(바운딩 구 투영 지름, px)와 직전 프레임 가시성으로 주기를 고른다.
+//      Full(매 프레임) / Half(2프레임에 1번) / Quarter(4프레임에 1번) / Frozen(안 함)
+//  - 시간은 앱이 계속 진행시키고, 평가하는 프레임에 그 시간으로 바로 샘플 (따라잡기).
+//  - 시간이 안 바뀌었으면(일시정지) 주기와 상관없이 평가를 건너뛴다.
+//  - phase를 인스턴스마다 다르게 줘서 Half/Quarter 인스턴스가 같은 프레임에 몰리지 않게.
+//================================================================================================
+
+enum class AnimRate : uint8_t { Frozen = 0, Full = 1, Half = 2, Quarter = 4 };
+
+const char* ToString(AnimRate r);
+
+struct AnimLODSettings
+{
+    bool  enabled = true;
+    float fullPx = 250.0f;     // 이 이상이면 Full
+    float halfPx = 100.0f;     // 이 이상이면 Half
+    float quarterPx = 20.0f;   // 이 이상이면 Quarter, 미만이면 Frozen
+    AnimRate offscreen = AnimRate::Frozen; // 직전 프레임에 안 보였으면
+};
+
+// 인스턴스별 스케줄 상태
+struct AnimLODInstance
+{
+    uint32_t phase = 0;
+    AnimRate rate = AnimRate::Full;
+    bool  visible = true;
+    float screenPx = 0.0f;
+
+    // 모델 공간 바운딩 구 (마지막 평가 포즈 기준)
+    DirectX::XMFLOAT3 center{ 0, 0, 0 };
+    float radius = 1.0f;
+
+    double lastEvalT = -1.0;
+    bool  force = true;        // 클립/베이크 전환, 시킹: 다음 프레임 무조건 평가 (AnimationSystem이 감지해 세운다)
+    uint32_t evals = 0, skips = 0;
+};
+
+class AnimScheduler
+{
+public:
+    using Matrix = DirectX::SimpleMath::Matrix;
+
+    AnimLODSettings settings;
+
+    // 인스턴스 등록: phase 배정
+    void Register(AnimLODInstance& inst) { inst.phase = mNextPhase++; }
+
+    // 프레임 시작: 카메라 (직전 프레임 투영을 써도 됨)
+    void BeginFrame(const Matrix& view, const Matrix& proj, float viewportH);
+
+    // 가시성/화면 크기 -> rate. enabled=false(숨김)면 Frozen.
+    void Classify(AnimLODInstance& inst, const Matrix& world, bool enabled) const;
+
+    // 이번 프레임에 평가할지. true면 호출 쪽이 EvaluatePose 후 UpdateBounds.
+    bool ShouldEvaluate(AnimLODInstance& inst, double t) const;
+
+    // 포즈 글로벌(노드 원점들)로 모델 공간 바운딩 구 갱신. 메쉬가 관절보다 조금 크니 여유를 준다.
+    static void UpdateBounds(AnimLODInstance& inst, const Matrix* global, size_t n);
+    // 정확한 모델 공간 AABB가 있을 때 (스킨: SkinnedSkeletal::Bounds). 여유 없이 외접 구.
+    static void UpdateBounds(AnimLODInstance& inst, const DirectX::BoundingBox& box);
+
+    uint64_t Frame() const noexcept { return mFrame; }
+
+private:
+    DirectX::BoundingFrustum mFrustum; // 뷰 공간
+    Matrix   mView = Matrix::Identity;
+    float    mPxPerUnitAt1 = 1.0f;     // 거리 1에서 월드 1단위가 몇 px인지 (proj._22 * H / 2)
+    uint64_t mFrame = 0;
+    uint32_t mNextPhase = 0;
+};
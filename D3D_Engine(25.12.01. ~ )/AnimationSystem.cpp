@@ -0,0 +1,106 @@
+﻿// AnimationSystem.cpp
+#include "../D3D_Core/pch.h"
+#include "AnimationSystem.h"
+#include "RigidSkeletal.h"
+#include "SkinnedSkeletal.h"
+
+#include <chrono>
+
+void AnimationSystem::Add(RigidSkeletal* rig, AnimPlayback* pb, AnimLODInstance* lod)
+{
+	if (!rig || !pb) return;
+	Entry e; e.rigid = rig; e.pb = pb; e.lod = lod;
+	CurrentState(e, e.lastClip, e.lastBaked);
+	e.lastT = pb->t;
+	mEntries.push_back(e);
+}
+
+void AnimationSystem::Add(SkinnedSkeletal* rig, AnimPlayback* pb, AnimLODInstance* lod)
+{
+	if (!rig || !pb) return;
+	Entry e; e.skinned = rig; e.pb = pb; e.lod = lod;
+	CurrentState(e, e.lastClip, e.lastBaked);
+	e.lastT = pb->t;
+	mEntries.push_back(e);
+}
+
+void AnimationSystem::Remove(const void* rig)
+{
+	mEntries.erase(std::remove_if(mEntries.begin(), mEntries.end(),
+		[&](const Entry& e) { return e.rigid == rig || e.skinned == rig; }), mEntries.end());
+}
+
+double AnimationSystem::DurationSec(const Entry& e)
+{
+	return e.rigid ? e.rigid->GetClipDurationSec() : e.skinned->DurationSec();
+}
+
+void AnimationSystem::CurrentState(const Entry& e, const void*& clip, const void*& baked)
+{
+	clip = e.rigid ? (const void*)e.rigid->GetClip() : (const void*)e.skinned->Clip();
+	baked = e.skinned ? (const void*)e.skinned->Baked() : nullptr;
+}
+
+void AnimationSystem::Evaluate(const Entry& e)
+{
+	using Clock = std::chrono::steady_clock;
+	const auto t0 = Clock::now();
+
+	AnimPlayback& pb = *e.pb;
+	if (e.rigid) {
+		e.rigid->EvaluatePose(pb.t, pb.loop);
+		if (e.lod) {
+			const auto& g = e.rigid->GetPoseGlobal();
+			AnimScheduler::UpdateBounds(*e.lod, g.data(), g.size());
+		}
+	}
+	else {
+		e.skinned->EvaluatePose(pb.t, pb.loop);
+		if (e.lod) AnimScheduler::UpdateBounds(*e.lod, e.skinned->Bounds());
+	}
+
+	pb.evalMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+void AnimationSystem::Update(double dt, bool advanceTime, const AnimScheduler* lod)
+{
+	const auto t0 = std::chrono::steady_clock::now();
+
+	// 1) 직렬: 시간 진행 + 대상 선정 (가볍다)
+	mJobs.clear();
+	for (Entry& e : mEntries) {
+		AnimPlayback& pb = *e.pb;
+
+		// 지난 Update 뒤에 바뀐 것: 클립/베이크 전환, 시간 점프(UI 시킹/되감기 등)
+		const void* clip; const void* baked;
+		CurrentState(e, clip, baked);
+		if (e.lod && (clip != e.lastClip || baked != e.lastBaked || pb.t != e.lastT)) e.lod->force = true;
+		e.lastClip = clip;
+		e.lastBaked = baked;
+
+		if (advanceTime && pb.play) pb.t += dt * pb.speed;
+
+		const double durSec = DurationSec(e);
+		if (durSec > 0.0) {
+			if (pb.loop) {
+				pb.t = fmod(pb.t, durSec); if (pb.t < 0.0) pb.t += durSec;
+			}
+			else {
+				if (pb.t >= durSec) { pb.t = durSec; pb.play = false; } // 끝에서 정지
+				if (pb.t < 0.0) { pb.t = 0.0;    pb.play = false; } // 앞에서 정지
+			}
+		}
+		e.lastT = pb.t;
+
+		if (lod && e.lod && !lod->ShouldEvaluate(*e.lod, pb.t)) continue;
+		mJobs.push_back(&e);
+	}
+
+	// 2) 병렬: 인스턴스 하나 = 작업 하나. 인스턴스끼리 쓰는 메모리가 겹치지 않는다.
+	mPool.ParallelFor(mJobs.size(), 1, [&](size_t b, size_t end) {
+		for (size_t i = b; i < end; ++i) Evaluate(*mJobs[i]);
+	});
+
+	// 3) ParallelFor가 join까지 하고 리턴
+	mLastMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
@@ -0,0 +1,77 @@
+﻿// AnimationSystem.h
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "WorkerPool.h"
+#include "AnimLOD.h"
+
+class RigidSkeletal;
+class SkinnedSkeletal;
+
+// 인스턴스별 재생 상태 (디버그 UI가 직접 만진다)
+struct AnimPlayback
+{
+    bool   play = true;
+    bool   loop = true;
+    float  speed = 1.0f;
+    double t = 0.0;
+    double evalMs = 0.0; // 마지막 EvaluatePose CPU 시간(ms)
+};
+
+//================================================================================================
+// 애니메이션 시스템 — 등록된 스켈레톤 인스턴스 전부를 워커 풀에서 한 번에 평가
+//  Update(dt):
+//   1) (직렬) 시간 진행 + 루프/클램프, LOD 스케줄러로 이번 프레임 평가 대상 고르기
+//      Update 사이에 클립/베이크가 바뀌었거나 시간이 외부에서 바뀌었으면(시킹) 강제 평가
+//   2) (병렬) 대상 인스턴스마다 EvaluatePose. 스레드는 자기 인스턴스의 포즈/팔레트만 쓴다.
+//      클립/에셋은 불변이라 공유 읽기만 한다.
+//   3) join 후 리턴 -> 바로 렌더해도 안전
+//  인스턴스/재생 상태/LOD 상태의 수명은 등록한 쪽이 책임진다 (Remove 또는 Clear 후 해제).
+//================================================================================================
+class AnimationSystem
+{
+public:
+    explicit AnimationSystem(unsigned workers = WorkerPool::DefaultWorkers()) : mPool(workers) {}
+
+    void Add(RigidSkeletal* rig, AnimPlayback* pb, AnimLODInstance* lod = nullptr);
+    void Add(SkinnedSkeletal* rig, AnimPlayback* pb, AnimLODInstance* lod = nullptr);
+    void Remove(const void* rig);
+    void Clear() { mEntries.clear(); }
+
+    // lod: 이번 프레임 Classify를 끝낸 스케줄러 (null이면 전부 매 프레임)
+    // advanceTime=false면 시간은 멈추고, 바뀐 것이 있는 인스턴스만 다시 평가
+    void Update(double dt, bool advanceTime = true, const AnimScheduler* lod = nullptr);
+
+    void SetWorkers(unsigned workers) { mPool.Resize(workers); }
+    unsigned Workers() const noexcept { return mPool.Workers(); }
+    WorkerPool& Pool() noexcept { return mPool; }
+
+    size_t Count() const noexcept { return mEntries.size(); }
+    size_t LastEvaluated() const noexcept { return mJobs.size(); }
+    double LastUpdateMs() const noexcept { return mLastMs; }
+
+private:
+    struct Entry
+    {
+        RigidSkeletal*   rigid = nullptr;
+        SkinnedSkeletal* skinned = nullptr;
+        AnimPlayback*    pb = nullptr;
+        AnimLODInstance* lod = nullptr;
+
+        // 지난 Update가 끝났을 때의 상태. 다음 Update 전에 바뀌었으면 (클립/베이크 전환, 시킹)
+        // LOD 주기와 상관없이 바로 평가하도록 lod->force를 세운다.
+        const void* lastClip = nullptr;
+        const void* lastBaked = nullptr;
+        double lastT = 0.0;
+    };
+
+    static double DurationSec(const Entry& e);
+    static void CurrentState(const Entry& e, const void*& clip, const void*& baked);
+    static void Evaluate(const Entry& e);
+
+    std::vector<Entry> mEntries;
+    std::vector<const Entry*> mJobs; // 이번 프레임 평가 대상 (직렬 단계에서 채움)
+    WorkerPool mPool;
+    double mLastMs = 0.0;
+};
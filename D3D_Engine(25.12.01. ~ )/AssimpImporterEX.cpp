@@ -1,14 +1,13 @@
 ﻿// AssimpImporterEx.cpp
-#include "../D3D_Core/pch.h"
-#include "AssimpImporterEx.h"
+// (pch 없이 빌드: 오프라인 쿠커와 공용. 파일명 대소문자 그대로 include - 리눅스)
+#include "AssimpImporterEX.h"
+#include "CookedFile.h"   // ToUtf8 / FromUtf8
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
-#include <filesystem>
+#include <algorithm>
 
-using std::filesystem::path;
-
-static unsigned MakeFlags(bool flipUV, bool leftHanded) {
+unsigned AssimpImporterEx::ImportFlags(bool flipUV, bool leftHanded) {
 	unsigned f = aiProcess_Triangulate
 		| aiProcess_JoinIdenticalVertices
 		| aiProcess_ImproveCacheLocality
@@ -22,26 +21,39 @@ static unsigned MakeFlags(bool flipUV, bool leftHanded) {
 	return f;
 }
 
+// aiString은 UTF-8 (바이트 단위로 넓히면 비ASCII 파일명이 깨진다)
 static std::wstring Widen(const aiString& s) {
-	std::string a = s.C_Str();
-	return std::wstring(a.begin(), a.end());
+	return CookedFile::FromUtf8(s.C_Str());
 }
 
-static std::wstring FileOnly(const std::wstring& p) {
-	return path(p).filename().wstring();
+// FBX에 박힌 경로는 보통 Windows 구분자(\). 리눅스에선 '/'만 구분자라 먼저 맞추고 마지막 요소만
+static std::wstring FileOnly(std::wstring p) {
+	std::replace(p.begin(), p.end(), L'\\', L'/');
+	return p.substr(p.find_last_of(L'/') + 1);
+}
+
+void AssimpImporterEx::ConfigureImporter(Assimp::Importer& imp)
+{
+	imp.SetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, false); // 이미 OK
+	imp.SetPropertyInteger(AI_CONFIG_PP_LBW_MAX_WEIGHTS, 4);
 }
 
 bool AssimpImporterEx::LoadFBX_PNTT_AndMaterials(
 	const std::wstring& pathW, MeshData_PNTT& out, bool flipUV, bool leftHanded)
 {
-	std::string pathA(pathW.begin(), pathW.end());
+	const std::string pathA = CookedFile::ToUtf8(pathW); // Assimp 경로는 UTF-8
 	Assimp::Importer imp;
-	imp.SetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, false); // 이미 OK
-	imp.SetPropertyInteger(AI_CONFIG_PP_LBW_MAX_WEIGHTS, 4);
+	ConfigureImporter(imp);
 
-	const aiScene* sc = imp.ReadFile(pathA.c_str(), MakeFlags(flipUV, leftHanded));
+	const aiScene* sc = imp.ReadFile(pathA.c_str(), ImportFlags(flipUV, leftHanded));
 	if (!sc || !sc->mRootNode) return false;
 
+	ConvertScene_PNTT_AndMaterials(sc, out);
+	return true;
+}
+
+void AssimpImporterEx::ConvertScene_PNTT_AndMaterials(const aiScene* sc, MeshData_PNTT& out)
+{
 	// 1) Materials (파일명만)
 	out.materials.clear();
 	out.materials.resize(sc->mNumMaterials);
@@ -94,7 +106,6 @@ bool AssimpImporterEx::LoadFBX_PNTT_AndMaterials(
 		baseV += m->mNumVertices; baseI += sm.indexCount;
 		out.submeshes.push_back(sm);
 	}
-	return true;
 }
 
 void AssimpImporterEx::ConvertAiMeshToPNTT(const aiMesh* am, MeshData_PNTT& out)
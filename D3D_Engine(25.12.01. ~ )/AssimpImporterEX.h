@@ -5,6 +5,7 @@
 // Assimp 전방 선언(헤더 의존 최소화)
 struct aiScene;
 struct aiMesh;
+namespace Assimp { class Importer; }
 
 class AssimpImporterEx {
 public:
@@ -14,6 +15,13 @@ public:
         bool flipUV = false,   
         bool leftHanded = true);
 
+    // LoadFBX_PNTT_AndMaterials가 쓰는 임포터 설정 / 후처리 플래그 (씬을 직접 읽는 쪽과 맞추기용)
+    static void ConfigureImporter(Assimp::Importer& imp);
+    static unsigned ImportFlags(bool flipUV, bool leftHanded);
+
+    // 이미 읽은 씬 -> 정점/인덱스/서브메시/재질 (LoadFBX_PNTT_AndMaterials의 변환 부분)
+    static void ConvertScene_PNTT_AndMaterials(const aiScene* sc, MeshData_PNTT& out);
+
     static void ConvertAiMeshToPNTT(const aiMesh* am, MeshData_PNTT& out);
 
     static void ExtractMaterials(const aiScene* sc, std::vector<MaterialCPU>& out);
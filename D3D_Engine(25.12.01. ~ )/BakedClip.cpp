@@ -0,0 +1,31 @@
+﻿// BakedClip.cpp
+#include "../D3D_Core/pch.h"
+#include "BakedClip.h"
+
+#include <cmath>
+
+BakedClip::BakedClip(uint32_t frames, uint32_t bones, uint32_t parts, float fps, double durationSec)
+	: mPalettes(size_t(frames) * bones)
+	, mPartGlobals(size_t(frames) * parts)
+	, mFrames(frames), mBones(bones), mParts(parts)
+	, mFps(fps), mDurationSec(durationSec)
+{
+}
+
+size_t BakedClip::MemoryBytes() const
+{
+	return sizeof(BakedClip) + mPalettes.capacity() * sizeof(BoneMatrix) + mPartGlobals.capacity() * sizeof(Matrix);
+}
+
+uint32_t BakedClip::FrameCount(double durationSec, uint32_t bones, uint32_t parts,
+	const BakeSettings& bs)
+{
+	const size_t perFrame = size_t(bones) * sizeof(BoneMatrix) + size_t(parts) * sizeof(Matrix);
+	if (perFrame == 0) return 0;
+
+	// 양 끝 포함: [0, duration]을 1/fps 간격으로
+	const double want = std::ceil(std::max(durationSec, 0.0) * std::max(bs.fps, 1.0f)) + 1.0;
+	const size_t cap = bs.maxBytes / perFrame;
+	const size_t frames = std::min<size_t>((size_t)want, cap);
+	return (frames >= 2) ? (uint32_t)frames : 0;
+}
@@ -0,0 +1,54 @@
+﻿// BakedClip.h
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <directxtk/SimpleMath.h>
+
+#include "PoseMath.h"
+
+//================================================================================================
+// 베이크된 클립 (군중용) — 클립을 고정 fps로 미리 샘플해 둔 스키닝 팔레트 테이블
+//  - 프레임 f의 팔레트(본 수만큼, 3x4 업로드 형태)와 파트 소유 노드 글로벌을 연속 배열로.
+//  - 재생은 두 프레임 사이 lerp(또는 가까운 프레임)뿐: 키 탐색/계층 순회/offset*global 없음.
+//  - 메모리는 maxBytes로 상한. 넘으면 fps를 낮춰 맞춘다(최소 2프레임).
+//  - 불변. 같은 (에셋, 클립, 설정)이면 ResourceManager::GetOrBakeClip으로 공유.
+//================================================================================================
+
+struct BakeSettings
+{
+    float  fps = 30.0f;
+    size_t maxBytes = 4u << 20;  // 클립 하나당 상한 (4 MB)
+};
+
+class BakedClip
+{
+public:
+    using Matrix = DirectX::SimpleMath::Matrix;
+    using BoneMatrix = PoseMath::BoneMatrix;
+
+    // frames x bones 팔레트, frames x parts 파트 글로벌을 채울 빈 테이블
+    BakedClip(uint32_t frames, uint32_t bones, uint32_t parts, float fps, double durationSec);
+
+    BoneMatrix* Palette(uint32_t f) { return mPalettes.data() + size_t(f) * mBones; }
+    const BoneMatrix* Palette(uint32_t f) const { return mPalettes.data() + size_t(f) * mBones; }
+    Matrix* PartGlobals(uint32_t f) { return mPartGlobals.data() + size_t(f) * mParts; }
+    const Matrix* PartGlobals(uint32_t f) const { return mPartGlobals.data() + size_t(f) * mParts; }
+
+    uint32_t Frames() const noexcept { return mFrames; }
+    uint32_t Bones() const noexcept { return mBones; }
+    uint32_t Parts() const noexcept { return mParts; }
+    float Fps() const noexcept { return mFps; }
+    double DurationSec() const noexcept { return mDurationSec; }
+    size_t MemoryBytes() const;
+
+    // 프레임 수 계산 (상한 적용). 2프레임도 안 들어가면 0
+    static uint32_t FrameCount(double durationSec, uint32_t bones, uint32_t parts,
+        const BakeSettings& bs);
+
+private:
+    std::vector<BoneMatrix> mPalettes; // [frame][bone]
+    std::vector<Matrix> mPartGlobals; // [frame][part]
+    uint32_t mFrames = 0, mBones = 0, mParts = 0;
+    float mFps = 0.0f;                // 실제 베이크 fps (상한 때문에 설정보다 낮을 수 있음)
+    double mDurationSec = 0.0;
+};
@@ -0,0 +1,137 @@
+﻿// BonePaletteBuffer.cpp
+#include "../D3D_Core/pch.h"
+#include "BonePaletteBuffer.h"
+
+#include <algorithm>
+
+bool BonePaletteBuffer::Init(ID3D11Device* dev, uint32_t initialMatrices)
+{
+	mDev = dev;
+	mUsed = 0;
+	mCPU.clear();
+	mFree.clear();
+	mDirty.clear();
+	++mGeneration;
+	return Create(std::max<uint32_t>(initialMatrices, 1));
+}
+
+void BonePaletteBuffer::Release()
+{
+	mSRV.Reset();
+	mBuf.Reset();
+	mDev.Reset();
+	mCPU.clear();
+	mFree.clear();
+	mDirty.clear();
+	mUsed = mCapacity = mLastUploaded = 0;
+	++mGeneration;
+}
+
+bool BonePaletteBuffer::Create(uint32_t capacity)
+{
+	mSRV.Reset();
+	mBuf.Reset();
+
+	D3D11_BUFFER_DESC bd{};
+	bd.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+	bd.Usage = D3D11_USAGE_DEFAULT; // 구간 단위 UpdateSubresource
+	bd.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+	bd.StructureByteStride = sizeof(BoneMatrix);
+	bd.ByteWidth = capacity * sizeof(BoneMatrix);
+	if (FAILED(mDev->CreateBuffer(&bd, nullptr, mBuf.GetAddressOf()))) { mCapacity = 0; return false; }
+
+	D3D11_SHADER_RESOURCE_VIEW_DESC sd{};
+	sd.Format = DXGI_FORMAT_UNKNOWN;
+	sd.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+	sd.Buffer.FirstElement = 0;
+	sd.Buffer.NumElements = capacity;
+	if (FAILED(mDev->CreateShaderResourceView(mBuf.Get(), &sd, mSRV.GetAddressOf()))) { mBuf.Reset(); mCapacity = 0; return false; }
+
+	mCapacity = capacity;
+	return true;
+}
+
+uint32_t BonePaletteBuffer::Allocate(uint32_t count)
+{
+	// first-fit: 앞쪽 구멍부터 메워 슬라이스가 버퍼 앞에 모이게
+	for (size_t i = 0; i < mFree.size(); ++i) {
+		Range& f = mFree[i];
+		if (f.end - f.begin < count) continue;
+		const uint32_t base = f.begin;
+		f.begin += count;
+		if (f.begin == f.end) mFree.erase(mFree.begin() + i);
+		return base;
+	}
+
+	const uint32_t base = mUsed;
+	mUsed += count;
+	mCPU.resize(mUsed);
+	return base;
+}
+
+void BonePaletteBuffer::Free(uint32_t base, uint32_t count)
+{
+	if (count == 0 || size_t(base) + count > mUsed) return;
+
+	Range r{ base, base + count };
+	auto it = std::lower_bound(mFree.begin(), mFree.end(), r.begin,
+		[](const Range& a, uint32_t b) { return a.begin < b; });
+	// 뒤 구간과 합치기
+	if (it != mFree.end() && it->begin == r.end) { r.end = it->end; it = mFree.erase(it); }
+	// 앞 구간과 합치기
+	if (it != mFree.begin() && std::prev(it)->end == r.begin) { std::prev(it)->end = r.end; }
+	else it = mFree.insert(it, r);
+
+	// 끝에 붙은 구멍이면 최고 수위를 내린다
+	if (!mFree.empty() && mFree.back().end == mUsed) {
+		mUsed = mFree.back().begin;
+		mFree.pop_back();
+		mCPU.resize(mUsed);
+	}
+}
+
+void BonePaletteBuffer::Write(uint32_t base, const BoneMatrix* palette, uint32_t count)
+{
+	if (count == 0 || size_t(base) + count > mUsed) return;
+	memcpy(mCPU.data() + base, palette, sizeof(BoneMatrix) * count);
+	mDirty.push_back({ base, base + count });
+}
+
+void BonePaletteBuffer::Upload(ID3D11DeviceContext* ctx)
+{
+	mLastUploaded = 0;
+	if (!mDev) return;
+
+	if (mUsed > mCapacity) {
+		uint32_t cap = std::max<uint32_t>(mCapacity, 1);
+		while (cap < mUsed) cap *= 2;
+		if (!Create(cap)) return;
+		// 새 버퍼는 비어 있으니 살아 있는 슬라이스 전부 (해제 구간 포함해도 한 번)
+		mDirty.assign(1, Range{ 0, mUsed });
+	}
+	if (mDirty.empty()) return;
+
+	// 겹치거나 맞닿은 구간은 합쳐서 한 번에
+	std::sort(mDirty.begin(), mDirty.end(), [](const Range& a, const Range& b) { return a.begin < b.begin; });
+	size_t out = 0;
+	for (size_t i = 1; i < mDirty.size(); ++i) {
+		if (mDirty[i].begin <= mDirty[out].end) mDirty[out].end = std::max(mDirty[out].end, mDirty[i].end);
+		else mDirty[++out] = mDirty[i];
+	}
+	mDirty.resize(out + 1);
+
+	for (const Range& r : mDirty) {
+		const uint32_t end = std::min(r.end, mUsed); // Write 뒤 Free로 줄었을 수 있다
+		if (r.begin >= end) continue;
+		const D3D11_BOX box{ r.begin * (UINT)sizeof(BoneMatrix), 0, 0, end * (UINT)sizeof(BoneMatrix), 1, 1 };
+		ctx->UpdateSubresource(mBuf.Get(), 0, &box, mCPU.data() + r.begin, 0, 0);
+		mLastUploaded += end - r.begin;
+	}
+	mDirty.clear();
+}
+
+void BonePaletteBuffer::Bind(ID3D11DeviceContext* ctx) const
+{
+	ID3D11ShaderResourceView* srv = mSRV.Get();
+	ctx->VSSetShaderResources(kSlot, 1, &srv);
+}
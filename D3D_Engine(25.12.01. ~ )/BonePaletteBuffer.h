@@ -0,0 +1,66 @@
+﻿// BonePaletteBuffer.h
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <directxtk/SimpleMath.h>
+
+#include "PoseMath.h"
+
+//================================================================================================
+// 스키닝 본 팔레트 공용 StructuredBuffer (VS t7)
+//  - 인스턴스마다 상주 슬라이스: Allocate로 한 번 자리를 받고, 포즈가 바뀐 프레임에만 Write.
+//    Upload는 이번 프레임에 쓰인 구간만 (인접 구간은 합쳐서) UpdateSubresource(box)로 올린다.
+//    LOD로 평가를 건너뛴 인스턴스는 업로드 0.
+//  - 슬라이스 시작 오프셋을 드로우마다 b4(RenderCB::BoneBase)로 넘기면
+//    셰이더는 BonePalette[gBoneBase + index]를 읽는다. (본 개수 제한 = 버퍼 크기)
+//  - 원소는 3x4 affine (PoseMath::BoneMatrix, 48B). HLSL은 Shared.hlsli의 SkinMatrix로 읽는다.
+//  - DEFAULT 버퍼 (부분 갱신). 용량이 모자라면 Upload에서 2배로 다시 만들고 전체를 한 번 올린다.
+//  - 절충: 거의 모든 인스턴스가 매 프레임 움직이고 슬라이스가 흩어져 있으면 UpdateSubresource
+//    여러 번이 Map(DISCARD) 한 번보다 호출이 많다. 해제 구간을 앞에서부터 재사용해 조각을 줄인다.
+//================================================================================================
+class BonePaletteBuffer
+{
+public:
+    using BoneMatrix = PoseMath::BoneMatrix;
+
+    static constexpr UINT kSlot = 7; // HLSL: StructuredBuffer<Bone3x4> BonePalette : register(t7)
+
+    bool Init(ID3D11Device* dev, uint32_t initialMatrices = 1024);
+    void Release();
+
+    // 팔레트 count개 자리 (해제된 구간 먼저 재사용, 없으면 끝에 붙임). 시작 오프셋 반환
+    uint32_t Allocate(uint32_t count);
+    // Release 뒤나 범위 밖이면 무시 (인스턴스가 버퍼보다 늦게 파괴돼도 안전)
+    void Free(uint32_t base, uint32_t count);
+
+    // 슬라이스 내용 갱신: CPU 사본에 복사하고 다음 Upload 대상 구간으로 기록
+    void Write(uint32_t base, const BoneMatrix* palette, uint32_t count);
+
+    // 기록된 구간만 업로드
+    void Upload(ID3D11DeviceContext* ctx);
+    void Bind(ID3D11DeviceContext* ctx) const;
+
+    uint32_t Used() const noexcept { return mUsed; }            // 할당 최고 수위 (행렬 수)
+    uint32_t Capacity() const noexcept { return mCapacity; }
+    uint32_t LastUploaded() const noexcept { return mLastUploaded; } // 마지막 Upload에서 올린 행렬 수
+    // Init/Release마다 증가: 인스턴스가 들고 있는 슬라이스가 아직 유효한지 비교용
+    uint32_t Generation() const noexcept { return mGeneration; }
+
+private:
+    struct Range { uint32_t begin, end; };
+
+    bool Create(uint32_t capacity);
+
+    Microsoft::WRL::ComPtr<ID3D11Device>             mDev;
+    Microsoft::WRL::ComPtr<ID3D11Buffer>             mBuf;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> mSRV;
+    std::vector<BoneMatrix> mCPU; // 슬라이스 전체의 CPU 사본 (mUsed개)
+    std::vector<Range> mFree;     // 해제 구간 (begin 오름차순, 인접 구간은 합쳐 둔다)
+    std::vector<Range> mDirty;    // 이번 프레임에 Write된 구간
+    uint32_t mUsed = 0;
+    uint32_t mCapacity = 0;
+    uint32_t mLastUploaded = 0;
+    uint32_t mGeneration = 0;
+};
@@ -0,0 +1,241 @@
+﻿// CookedFile.cpp
+// (pch 없이 빌드: 오프라인 쿠커와 공용)
+#include "CookedFile.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+// wstring 경로 -> 파일 시스템 경로 (POSIX는 UTF-8 바이트 그대로)
+static fs::path NativePath(const std::wstring& w)
+{
+#if defined(_WIN32)
+	return fs::path(w);
+#else
+	return fs::u8path(CookedFile::ToUtf8(w));
+#endif
+}
+
+// ===== MappedFile =====
+MappedFile& MappedFile::operator=(MappedFile&& o) noexcept
+{
+	if (this != &o) {
+		Close();
+		std::swap(mData, o.mData);
+		std::swap(mSize, o.mSize);
+#if defined(_WIN32)
+		std::swap(mFile, o.mFile);
+		std::swap(mMapping, o.mMapping);
+#else
+		std::swap(mFd, o.mFd);
+#endif
+	}
+	return *this;
+}
+
+bool MappedFile::Open(const std::wstring& path)
+{
+	Close();
+#if defined(_WIN32)
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) { CloseHandle(file); return false; }
+
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) { CloseHandle(file); return false; }
+
+	const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view) { CloseHandle(mapping); CloseHandle(file); return false; }
+
+	mFile = file;
+	mMapping = mapping;
+	mData = static_cast<const uint8_t*>(view);
+	mSize = (size_t)size.QuadPart;
+#else
+	const int fd = ::open(NativePath(path).c_str(), O_RDONLY);
+	if (fd < 0) return false;
+
+	struct stat st {};
+	if (::fstat(fd, &st) != 0 || st.st_size <= 0) { ::close(fd); return false; }
+
+	void* view = ::mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (view == MAP_FAILED) { ::close(fd); return false; }
+
+	mFd = fd;
+	mData = static_cast<const uint8_t*>(view);
+	mSize = (size_t)st.st_size;
+#endif
+	return true;
+}
+
+void MappedFile::Close()
+{
+#if defined(_WIN32)
+	if (mData) UnmapViewOfFile(mData);
+	if (mMapping) CloseHandle(mMapping);
+	if (mFile) CloseHandle(mFile);
+	mMapping = mFile = nullptr;
+#else
+	if (mData) ::munmap(const_cast<uint8_t*>(mData), mSize);
+	if (mFd >= 0) ::close(mFd);
+	mFd = -1;
+#endif
+	mData = nullptr;
+	mSize = 0;
+}
+
+// ===== 해시 =====
+static inline uint64_t Rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+uint64_t CookedFile::HashBytes(const void* data, size_t size, uint64_t seed)
+{
+	constexpr uint64_t kMul0 = 0x9E3779B97F4A7C15ull;
+	constexpr uint64_t kMul1 = 0xC2B2AE3D27D4EB4Full;
+	const uint8_t* p = static_cast<const uint8_t*>(data);
+
+	// 32바이트 블록: 레인 4개가 서로 독립이라 곱셈 지연이 겹친다
+	uint64_t h[4] = { seed + kMul0 + kMul1, seed + kMul1, seed, seed - kMul0 };
+	size_t i = 0;
+	for (; i + 32 <= size; i += 32) {
+		for (int l = 0; l < 4; ++l) {
+			uint64_t w;
+			std::memcpy(&w, p + i + l * 8, 8);
+			h[l] = Rotl64(h[l] + w * kMul1, 31) * kMul0;
+		}
+	}
+
+	uint64_t r = (uint64_t)size * kMul0;
+	for (int l = 0; l < 4; ++l) r = Rotl64(r ^ h[l], 27) * kMul1 + kMul0;
+	for (; i < size; ++i) r = (r ^ p[i]) * 0x100000001B3ull;
+
+	// 마무리 섞기
+	r ^= r >> 33; r *= 0xFF51AFD7ED558CCDull;
+	r ^= r >> 33; r *= 0xC4CEB9FE1A85EC53ull;
+	r ^= r >> 33;
+	return r;
+}
+
+bool CookedFile::StampSource(const std::wstring& path, uint32_t options, SourceStamp& out)
+{
+	MappedFile f;
+	if (!f.Open(path)) return false;
+	out = {};
+	out.size = f.Size();
+	out.hash = HashBytes(f.Data(), f.Size());
+	out.options = options;
+	return true;
+}
+
+// ===== 쓰기 =====
+bool CookedFile::WriteFileAtomic(const std::wstring& path, const void* data, size_t size)
+{
+	const fs::path dst = NativePath(path);
+	fs::path tmp = dst;
+	tmp += L".tmp";
+
+	std::error_code ec;
+	if (dst.has_parent_path()) fs::create_directories(dst.parent_path(), ec);
+
+#if defined(_WIN32)
+	FILE* fp = _wfopen(tmp.c_str(), L"wb");
+#else
+	FILE* fp = std::fopen(tmp.c_str(), "wb");
+#endif
+	if (!fp) return false;
+	const bool ok = std::fwrite(data, 1, size, fp) == size;
+	if (std::fclose(fp) != 0 || !ok) { fs::remove(tmp, ec); return false; }
+
+	fs::rename(tmp, dst, ec); // 같은 볼륨이면 덮어쓰기 포함 원자적
+	if (ec) { fs::remove(tmp, ec); return false; }
+	return true;
+}
+
+std::wstring CookedFile::CookedPath(const std::wstring& sourcePath, const wchar_t* ext)
+{
+	fs::path p = NativePath(sourcePath);
+	p.replace_extension(NativePath(ext));
+	return FromUtf8(p.u8string());
+}
+
+// ===== UTF-8 =====
+std::string CookedFile::ToUtf8(const std::wstring& w)
+{
+#if defined(_WIN32)
+	return fs::path(w).u8string();
+#else
+	std::string s;
+	s.reserve(w.size());
+	for (wchar_t wc : w) {
+		uint32_t c = (uint32_t)wc;
+		if (c > 0x10FFFF || (c >= 0xD800 && c < 0xE000)) c = 0xFFFD;
+		if (c < 0x80) {
+			s += char(c);
+		}
+		else if (c < 0x800) {
+			s += char(0xC0 | (c >> 6));
+			s += char(0x80 | (c & 0x3F));
+		}
+		else if (c < 0x10000) {
+			s += char(0xE0 | (c >> 12));
+			s += char(0x80 | ((c >> 6) & 0x3F));
+			s += char(0x80 | (c & 0x3F));
+		}
+		else {
+			s += char(0xF0 | (c >> 18));
+			s += char(0x80 | ((c >> 12) & 0x3F));
+			s += char(0x80 | ((c >> 6) & 0x3F));
+			s += char(0x80 | (c & 0x3F));
+		}
+	}
+	return s;
+#endif
+}
+
+std::wstring CookedFile::FromUtf8(const std::string& s)
+{
+#if defined(_WIN32)
+	return fs::u8path(s).wstring();
+#else
+	std::wstring w;
+	w.reserve(s.size());
+	const size_t n = s.size();
+	for (size_t i = 0; i < n;) {
+		const uint8_t b = (uint8_t)s[i];
+		const int len = (b < 0x80) ? 1 : (b >> 5) == 0x6 ? 2 : (b >> 4) == 0xE ? 3 : (b >> 3) == 0x1E ? 4 : 0;
+		uint32_t c = (len == 1) ? b : (len == 2) ? (b & 0x1Fu) : (len == 3) ? (b & 0x0Fu) : (b & 0x07u);
+		bool ok = len > 0 && i + len <= n;
+		for (int k = 1; ok && k < len; ++k) {
+			const uint8_t t = (uint8_t)s[i + k];
+			ok = (t & 0xC0) == 0x80;
+			c = (c << 6) | (t & 0x3Fu);
+		}
+		// 과잉 길이 / 서로게이트 / 범위 밖도 잘못된 것으로
+		static const uint32_t kMin[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+		if (ok && (c < kMin[len] || c > 0x10FFFF || (c >= 0xD800 && c < 0xE000))) ok = false;
+		w += ok ? (wchar_t)c : (wchar_t)0xFFFD;
+		i += ok ? len : 1;
+	}
+	return w;
+#endif
+}
@@ -0,0 +1,111 @@
+﻿// CookedFile.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+//================================================================================================
+// 쿡 파일 공용 — 읽기 전용 메모리 맵 + 원본 스탬프 + 원자적 쓰기
+//  - MappedFile : 파일 전체를 읽기 전용으로 매핑 (Windows: CreateFileMapping / 그 외: mmap).
+//  - SourceStamp: 원본 크기 + 내용 해시 + 임포트 옵션. mtime은 쓰지 않는다
+//                 (다른 머신/OS에서 쿡한 파일도 내용이 같으면 그대로 유효).
+//  - Blob       : 섹션을 정렬해서 이어 붙이는 쓰기 버퍼. 오프셋은 파일 시작 기준이라 재배치 불필요.
+//  - 경로 문자열은 wstring. UTF-8 변환은 ToUtf8/FromUtf8로 (Windows = UTF-16, 그 외 wchar_t = UTF-32).
+//  - D3D/pch 의존 없음 (오프라인 쿠커와 공용).
+//================================================================================================
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& o) noexcept { *this = std::move(o); }
+    MappedFile& operator=(MappedFile&& o) noexcept;
+
+    // 없거나 비어 있으면 false
+    bool Open(const std::wstring& path);
+    void Close();
+
+    bool IsOpen() const noexcept { return mData != nullptr; }
+    const uint8_t* Data() const noexcept { return mData; }
+    size_t Size() const noexcept { return mSize; }
+
+private:
+    const uint8_t* mData = nullptr;
+    size_t mSize = 0;
+#if defined(_WIN32)
+    void* mFile = nullptr;     // HANDLE
+    void* mMapping = nullptr;  // HANDLE
+#else
+    int mFd = -1;
+#endif
+};
+
+struct SourceStamp
+{
+    uint64_t size = 0;
+    uint64_t hash = 0;     // CookedFile::HashBytes(원본 전체)
+    uint32_t options = 0;  // 포맷별 임포트 옵션 비트 (flipUV 등)
+    uint32_t pad = 0;
+
+    bool operator==(const SourceStamp& o) const noexcept { return size == o.size && hash == o.hash && options == o.options; }
+    bool operator!=(const SourceStamp& o) const noexcept { return !(*this == o); }
+};
+
+namespace CookedFile
+{
+    // 64bit 내용 해시 (4레인 곱-회전, 리틀 엔디언 가정). 암호용 아님.
+    uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0);
+
+    // 원본을 매핑해 크기/해시 계산. 파일이 없으면 false
+    bool StampSource(const std::wstring& path, uint32_t options, SourceStamp& out);
+
+    // path.tmp에 쓰고 rename (반쯤 쓴 쿡 파일이 남지 않게)
+    bool WriteFileAtomic(const std::wstring& path, const void* data, size_t size);
+
+    // 원본 옆 쿡 파일 경로: "Tree/Tree.fbx" + ".mesh" -> "Tree/Tree.mesh"
+    std::wstring CookedPath(const std::wstring& sourcePath, const wchar_t* ext);
+
+    // 경로/이름 문자열 UTF-8 <-> wstring. Windows는 std::filesystem(u8path/u8string),
+    // 그 외는 직접 변환: libstdc++ path의 wide 변환은 로캘과 상관없이 비ASCII에서 예외를 던진다.
+    // 잘못된 UTF-8 바이트는 U+FFFD로.
+    std::string ToUtf8(const std::wstring& w);
+    std::wstring FromUtf8(const std::string& s);
+
+    // 섹션 단위로 붙여 쓰는 버퍼. Append는 정렬 후 파일 오프셋을 돌려준다.
+    struct Blob
+    {
+        std::vector<uint8_t> bytes;
+
+        size_t Align(size_t a)
+        {
+            bytes.resize((bytes.size() + a - 1) / a * a, 0);
+            return bytes.size();
+        }
+        // p == nullptr면 0으로 채운 자리만 잡는다 (헤더는 마지막에 At으로 채움)
+        size_t Append(const void* p, size_t n, size_t align = 16)
+        {
+            const size_t at = Align(align);
+            bytes.resize(at + n);
+            if (p && n) std::memcpy(bytes.data() + at, p, n);
+            return at;
+        }
+        template<class T> size_t AppendArray(const T* p, size_t count, size_t align = 16)
+        {
+            return Append(p, count * sizeof(T), align);
+        }
+        template<class T> T& At(size_t offset) { return *reinterpret_cast<T*>(bytes.data() + offset); }
+    };
+
+    // 매핑된 파일 안의 [offset, offset + count * sizeof(T)) 구간 (범위/정렬 검사). 실패하면 nullptr
+    template<class T> const T* Section(const MappedFile& f, uint64_t offset, uint64_t count)
+    {
+        if (offset % alignof(T) != 0 || offset > f.Size()) return nullptr;
+        if (count > (f.Size() - offset) / sizeof(T)) return nullptr;
+        return reinterpret_cast<const T*>(f.Data() + offset);
+    }
+}
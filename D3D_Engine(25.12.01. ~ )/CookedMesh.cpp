@@ -0,0 +1,201 @@
+﻿// CookedMesh.cpp
+// (pch 없이 빌드: 오프라인 쿠커와 공용)
+#include "CookedMesh.h"
+#include "AssimpImporterEX.h"
+
+#include <cfloat>
+
+static_assert(sizeof(VertexCPU_PNTT) == 48, "CookedMesh: bump kVersion when VertexCPU_PNTT changes");
+static_assert(sizeof(SubMeshCPU) == 16, "CookedMesh: bump kVersion when SubMeshCPU changes");
+
+// MaterialCPU 텍스처 필드 순서 (CookedMaterial::tex와 같은 순서)
+static std::wstring MaterialCPU::* const kTexFields[5] = {
+	&MaterialCPU::diffuse, &MaterialCPU::normal, &MaterialCPU::specular, &MaterialCPU::emissive, &MaterialCPU::opacity
+};
+
+// 파일명 문자열은 UTF-16 코드 유닛으로 담는다. Windows는 wchar_t 그대로,
+// wchar_t가 4바이트인 플랫폼(리눅스 쿠커)은 BMP 밖 문자를 서로게이트 쌍으로 바꾼다.
+static void AppendUtf16(const std::wstring& s, std::vector<uint16_t>& out)
+{
+	for (wchar_t c : s) {
+		const uint32_t cp = (uint32_t)c;
+		if (sizeof(wchar_t) == 4 && cp > 0xFFFF) {
+			out.push_back(uint16_t(0xD800 + ((cp - 0x10000) >> 10)));
+			out.push_back(uint16_t(0xDC00 + ((cp - 0x10000) & 0x3FF)));
+		}
+		else {
+			out.push_back((uint16_t)cp);
+		}
+	}
+}
+
+static std::wstring FromUtf16(const uint16_t* s, size_t n)
+{
+	std::wstring w;
+	w.reserve(n);
+	for (size_t i = 0; i < n; ++i) {
+		uint32_t cp = s[i];
+		if (sizeof(wchar_t) == 4 && cp >= 0xD800 && cp < 0xDC00 && i + 1 < n && s[i + 1] >= 0xDC00 && s[i + 1] < 0xE000)
+			cp = 0x10000 + ((cp - 0xD800) << 10) + (s[++i] - 0xDC00u);
+		w.push_back((wchar_t)cp);
+	}
+	return w;
+}
+
+static void ComputeBounds(const VertexCPU_PNTT* v, size_t n, float mn[3], float mx[3])
+{
+	if (n == 0) {
+		mn[0] = mn[1] = mn[2] = mx[0] = mx[1] = mx[2] = 0.0f;
+		return;
+	}
+	mn[0] = mn[1] = mn[2] = FLT_MAX;
+	mx[0] = mx[1] = mx[2] = -FLT_MAX;
+	for (size_t i = 0; i < n; ++i) {
+		const float p[3] = { v[i].px, v[i].py, v[i].pz };
+		for (int k = 0; k < 3; ++k) {
+			if (p[k] < mn[k]) mn[k] = p[k];
+			if (p[k] > mx[k]) mx[k] = p[k];
+		}
+	}
+}
+
+uint32_t CookedMesh::Options(bool flipUV, bool leftHanded)
+{
+	return (flipUV ? 1u : 0u) | (leftHanded ? 2u : 0u);
+}
+
+void CookedMesh::PackMaterials(const std::vector<MaterialCPU>& in, std::vector<CookedMaterial>& mats, std::vector<uint16_t>& strings)
+{
+	mats.assign(in.size(), CookedMaterial{});
+	for (size_t i = 0; i < in.size(); ++i) {
+		const MaterialCPU& m = in[i];
+		for (int t = 0; t < 5; ++t) {
+			const std::wstring& s = m.*kTexFields[t];
+			mats[i].tex[t][0] = (uint32_t)strings.size();
+			AppendUtf16(s, strings);
+			mats[i].tex[t][1] = (uint32_t)strings.size() - mats[i].tex[t][0]; // 코드 유닛 수
+		}
+		for (int k = 0; k < 3; ++k) mats[i].diffuseColor[k] = m.diffuseColor[k];
+	}
+}
+
+bool CookedMesh::UnpackMaterials(const CookedMaterial* mats, size_t count,
+	const uint16_t* strings, uint64_t stringCount, std::vector<MaterialCPU>& out)
+{
+	out.assign(count, MaterialCPU{});
+	for (size_t i = 0; i < count; ++i) {
+		MaterialCPU& m = out[i];
+		for (int t = 0; t < 5; ++t) {
+			const uint32_t at = mats[i].tex[t][0], len = mats[i].tex[t][1];
+			if ((uint64_t)at + len > stringCount) return false;
+			m.*kTexFields[t] = FromUtf16(strings + at, len);
+		}
+		for (int k = 0; k < 3; ++k) m.diffuseColor[k] = mats[i].diffuseColor[k];
+	}
+	return true;
+}
+
+bool CookedMesh::Write(const std::wstring& path, const MeshData_PNTT& src, const SourceStamp& stamp)
+{
+	std::vector<uint16_t> strings;
+	std::vector<CookedMaterial> mats;
+	PackMaterials(src.materials, mats, strings);
+
+	CookedFile::Blob blob;
+	blob.Append(nullptr, sizeof(CookedMeshHeader));
+	CookedMeshHeader h;
+	h.magic = kMagic;
+	h.version = kVersion;
+	h.source = stamp;
+	h.vertexCount = (uint32_t)src.vertices.size();
+	h.indexCount = (uint32_t)src.indices.size();
+	h.submeshCount = (uint32_t)src.submeshes.size();
+	h.materialCount = (uint32_t)mats.size();
+	h.vertexOffset = blob.AppendArray(src.vertices.data(), src.vertices.size());
+	h.indexOffset = blob.AppendArray(src.indices.data(), src.indices.size());
+	h.submeshOffset = blob.AppendArray(src.submeshes.data(), src.submeshes.size());
+	h.materialOffset = blob.AppendArray(mats.data(), mats.size());
+	h.stringOffset = blob.AppendArray(strings.data(), strings.size());
+	h.stringCount = strings.size();
+	ComputeBounds(src.vertices.data(), src.vertices.size(), h.boundsMin, h.boundsMax);
+	h.fileSize = blob.Align(16);
+	blob.At<CookedMeshHeader>(0) = h;
+
+	return CookedFile::WriteFileAtomic(path, blob.bytes.data(), blob.bytes.size());
+}
+
+bool CookedMesh::Open(const std::wstring& path, const SourceStamp* expect, MappedFile& file, CookedMeshView& out)
+{
+	if (!file.Open(path)) return false;
+
+	const CookedMeshHeader* h = CookedFile::Section<CookedMeshHeader>(file, 0, 1);
+	bool ok = h && h->magic == kMagic && h->version == kVersion
+		&& (!expect || h->source == *expect) && h->fileSize == file.Size();
+
+	const CookedMaterial* mats = nullptr;
+	const uint16_t* strings = nullptr;
+	if (ok) {
+		out.vertices = CookedFile::Section<VertexCPU_PNTT>(file, h->vertexOffset, h->vertexCount);
+		out.indices = CookedFile::Section<uint32_t>(file, h->indexOffset, h->indexCount);
+		out.submeshes = CookedFile::Section<SubMeshCPU>(file, h->submeshOffset, h->submeshCount);
+		mats = CookedFile::Section<CookedMaterial>(file, h->materialOffset, h->materialCount);
+		strings = CookedFile::Section<uint16_t>(file, h->stringOffset, h->stringCount);
+		ok = out.vertices && out.indices && out.submeshes && mats && strings;
+	}
+	for (uint32_t i = 0; ok && i < h->submeshCount; ++i) {
+		const SubMeshCPU& sm = out.submeshes[i];
+		ok = (uint64_t)sm.indexStart + sm.indexCount <= h->indexCount;
+	}
+	if (ok) ok = UnpackMaterials(mats, h->materialCount, strings, h->stringCount, out.materials);
+	if (!ok) { file.Close(); out = {}; return false; }
+
+	out.vertexCount = h->vertexCount;
+	out.indexCount = h->indexCount;
+	out.submeshCount = h->submeshCount;
+	for (int k = 0; k < 3; ++k) { out.boundsMin[k] = h->boundsMin[k]; out.boundsMax[k] = h->boundsMax[k]; }
+	return true;
+}
+
+void CookedMesh::ViewOf(const MeshData_PNTT& src, CookedMeshView& out)
+{
+	ViewOf(src.vertices.data(), (uint32_t)src.vertices.size(), src.indices.data(), (uint32_t)src.indices.size(),
+		src.submeshes.data(), (uint32_t)src.submeshes.size(), out);
+	out.materials = src.materials;
+}
+
+void CookedMesh::ViewOf(const VertexCPU_PNTT* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount,
+	const SubMeshCPU* submeshes, uint32_t submeshCount, CookedMeshView& out)
+{
+	out.vertices = vertices;
+	out.indices = indices;
+	out.submeshes = submeshes;
+	out.vertexCount = vertexCount;
+	out.indexCount = indexCount;
+	out.submeshCount = submeshCount;
+	out.materials.clear();
+	ComputeBounds(vertices, vertexCount, out.boundsMin, out.boundsMax);
+}
+
+bool CookedMesh::LoadOrCook(const std::wstring& fbxPath, bool flipUV, bool leftHanded,
+	MappedFile& file, MeshData_PNTT& imported, CookedMeshView& out, bool* wasCooked)
+{
+	if (wasCooked) *wasCooked = false;
+
+	const std::wstring cookedPath = CookedFile::CookedPath(fbxPath, L".mesh");
+	SourceStamp stamp;
+	const bool haveSource = CookedFile::StampSource(fbxPath, Options(flipUV, leftHanded), stamp);
+
+	// 원본이 없으면 (배포본 등) 쿡 파일만으로
+	if (Open(cookedPath, haveSource ? &stamp : nullptr, file, out)) {
+		if (wasCooked) *wasCooked = true;
+		return true;
+	}
+	if (!haveSource) return false;
+
+	// stale/없음 -> Assimp (쓰기 실패는 무시: 다음 실행에 다시 쿡)
+	if (!AssimpImporterEx::LoadFBX_PNTT_AndMaterials(fbxPath, imported, flipUV, leftHanded))
+		return false;
+	Write(cookedPath, imported, stamp);
+	ViewOf(imported, out);
+	return true;
+}
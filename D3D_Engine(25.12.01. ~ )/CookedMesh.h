@@ -0,0 +1,82 @@
+﻿// CookedMesh.h
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CookedFile.h"
+#include "MeshDataEx.h"
+
+//================================================================================================
+// 쿡된 정적 메시 (.mesh) — StaticMesh::Build가 먹는 형태 그대로 저장
+//  - [헤더][정점 VertexCPU_PNTT][인덱스 u32][서브메시 SubMeshCPU][머티리얼][문자열(UTF-16)]
+//    섹션은 16바이트 정렬, 오프셋은 파일 시작 기준. 매핑한 포인터를 그대로 버퍼 생성에 넘긴다.
+//  - 원본 FBX의 SourceStamp(크기 + 해시 + 임포트 옵션)와 버전이 다르면 stale -> Assimp로 다시 쿡.
+//  - 리틀 엔디언 고정 (x86/ARM 공용). 구조체 배치가 바뀌면 kVersion을 올릴 것.
+//================================================================================================
+struct CookedMeshHeader
+{
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    SourceStamp source;
+    uint64_t fileSize = 0;
+
+    uint32_t vertexCount = 0, indexCount = 0, submeshCount = 0, materialCount = 0;
+    uint64_t vertexOffset = 0, indexOffset = 0, submeshOffset = 0, materialOffset = 0;
+    uint64_t stringOffset = 0, stringCount = 0;   // char16 단위
+
+    float boundsMin[3] = { 0, 0, 0 };
+    float boundsMax[3] = { 0, 0, 0 };
+};
+
+// 텍스처 파일명은 문자열 섹션의 (시작, 길이)
+struct CookedMaterial
+{
+    uint32_t tex[5][2] = {};   // diffuse, normal, specular, emissive, opacity
+    float diffuseColor[3] = { 1, 1, 1 };
+    uint32_t pad = 0;
+};
+
+// 버퍼 생성에 넘길 뷰. 포인터는 매핑(또는 임포트 결과)을 가리키므로 그쪽이 살아 있는 동안만 유효.
+struct CookedMeshView
+{
+    const VertexCPU_PNTT* vertices = nullptr;
+    const uint32_t* indices = nullptr;
+    const SubMeshCPU* submeshes = nullptr;
+    uint32_t vertexCount = 0, indexCount = 0, submeshCount = 0;
+    std::vector<MaterialCPU> materials;  // 문자열이라 복사 (몇 개뿐)
+    float boundsMin[3] = { 0, 0, 0 };
+    float boundsMax[3] = { 0, 0, 0 };
+};
+
+namespace CookedMesh
+{
+    constexpr uint32_t kMagic = 0x4853454D; // "MESH"
+    constexpr uint32_t kVersion = 1;
+
+    // 임포트 옵션 -> SourceStamp::options
+    uint32_t Options(bool flipUV, bool leftHanded);
+
+    bool Write(const std::wstring& path, const MeshData_PNTT& src, const SourceStamp& stamp);
+
+    // 쿡 파일을 매핑해 뷰를 채운다. 없음/버전·원본 불일치/손상이면 false
+    //  expect == nullptr : 원본 없이 (배포본 등) 쿡 파일만 믿고 연다
+    bool Open(const std::wstring& path, const SourceStamp* expect, MappedFile& file, CookedMeshView& out);
+
+    // 머티리얼 <-> (CookedMaterial + UTF-16 문자열 섹션). .skel과 공용
+    void PackMaterials(const std::vector<MaterialCPU>& in, std::vector<CookedMaterial>& mats, std::vector<uint16_t>& strings);
+    bool UnpackMaterials(const CookedMaterial* mats, size_t count,
+        const uint16_t* strings, uint64_t stringCount, std::vector<MaterialCPU>& out);
+
+    // 메모리에 있는 임포트 결과를 같은 뷰로 (바운드 계산 포함)
+    void ViewOf(const MeshData_PNTT& src, CookedMeshView& out);
+    // 배열만 있을 때 (머티리얼은 비워 둔다)
+    void ViewOf(const VertexCPU_PNTT* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount,
+        const SubMeshCPU* submeshes, uint32_t submeshCount, CookedMeshView& out);
+
+    // 원본 옆 .mesh가 유효하면 매핑, 아니면 Assimp 임포트 후 .mesh를 쓰고 임포트 결과를 뷰로.
+    //  file / imported : 뷰 포인터가 가리킬 저장소 (호출 쪽이 Build 끝날 때까지 들고 있는다)
+    //  wasCooked       : 쿡 파일에서 읽었으면 true
+    bool LoadOrCook(const std::wstring& fbxPath, bool flipUV, bool leftHanded,
+        MappedFile& file, MeshData_PNTT& imported, CookedMeshView& out, bool* wasCooked = nullptr);
+}
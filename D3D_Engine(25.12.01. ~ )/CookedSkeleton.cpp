@@ -0,0 +1,373 @@
+﻿// CookedSkeleton.cpp
+// (pch 없이 빌드: 오프라인 쿠커와 공용)
+#include "CookedSkeleton.h"
+#include "WorkerPool.h"
+
+#include <type_traits>
+
+static_assert(sizeof(CookedSkelHeader) == 192, "CookedSkeleton: bump kVersion when the header changes");
+static_assert(sizeof(CookedSkelNode) == 80 && sizeof(CookedSkelBone) == 80 && sizeof(CookedSkelPart) == 48,
+	"CookedSkeleton: bump kVersion when table records change");
+static_assert(sizeof(VertexCPU_PNTT_BW) == 72 && sizeof(SK_BoneBox) == 28,
+	"CookedSkeleton: bump kVersion when part data changes");
+static_assert(sizeof(CookedClip) == 168 && sizeof(CookedChannel) == 44 && sizeof(AnimTrack) == 12,
+	"CookedSkeleton: bump kVersion when clip records change");
+static_assert(sizeof(AnimQuat48) == 6 && sizeof(AnimVec48) == 6, "CookedSkeleton: key formats changed");
+
+// 이름 섹션 (UTF-8 바이트, 끝 0 없음)
+static void PutName(std::string& names, const std::string& s, uint32_t out[2])
+{
+	out[0] = (uint32_t)names.size();
+	out[1] = (uint32_t)s.size();
+	names += s;
+}
+
+static bool GetName(const char* names, uint64_t nameBytes, const uint32_t ref[2], std::string& out)
+{
+	if ((uint64_t)ref[0] + ref[1] > nameBytes) return false;
+	out.assign(names + ref[0], ref[1]);
+	return true;
+}
+
+// 매핑 구간 -> vector (한 번에 복사)
+template<class T>
+static bool CopySection(const MappedFile& f, uint64_t offset, uint64_t count, std::vector<T>& out)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "section types must be trivially copyable");
+	const T* p = CookedFile::Section<T>(f, offset, count);
+	if (!p) return false;
+	out.assign(p, p + count);
+	return true;
+}
+
+std::wstring CookedSkeleton::SkelPath(const std::wstring& fbxPath, bool skinned)
+{
+	return CookedFile::CookedPath(fbxPath, skinned ? L".skel" : L".rigid.skel");
+}
+
+std::wstring CookedSkeleton::AnimPath(const std::wstring& fbxPath)
+{
+	return CookedFile::CookedPath(fbxPath, L".anim");
+}
+
+uint32_t CookedSkeleton::SkelOptions(bool skinned)
+{
+	return skinned ? 1u : 0u;
+}
+
+uint32_t CookedSkeleton::AnimOptions(const AnimCompressSettings& cs)
+{
+	// 압축 결과에 영향을 주는 것 전부. kReduceRev: 키 제거 규칙이 바뀌면 올린다
+	// (2: 런타임 nlerp 기준 판정 + 본별 허용 오차)
+	constexpr float kReduceRev = 2.0f;
+	const float v[6] = { kReduceRev, cs.posTol, cs.rotTolDeg, cs.scaleTol, cs.resampleRate, cs.depthScale };
+	uint64_t h = CookedFile::HashBytes(v, sizeof(v));
+	for (const auto& bs : cs.boneScale) {
+		h = CookedFile::HashBytes(bs.first.data(), bs.first.size() + 1, h); // 널 포함: 이름 경계
+		h = CookedFile::HashBytes(&bs.second, sizeof(bs.second), h);
+	}
+	return (uint32_t)(h ^ (h >> 32));
+}
+
+// ===== .skel =====
+bool CookedSkeleton::WriteSkel(const std::wstring& path, const SkeletonCPU& src, const SourceStamp& stamp)
+{
+	std::string names;
+	std::vector<CookedSkelNode> nodes(src.nodes.size());
+	for (size_t i = 0; i < src.nodes.size(); ++i) {
+		nodes[i].parent = src.nodes[i].parent;
+		nodes[i].bindLocal = src.nodes[i].bindLocal;
+		PutName(names, src.nodes[i].name, nodes[i].name);
+	}
+	std::vector<CookedSkelBone> bones(src.bones.size());
+	for (size_t i = 0; i < src.bones.size(); ++i) {
+		bones[i].node = src.bones[i].node;
+		bones[i].offset = src.bones[i].offset;
+		PutName(names, src.bones[i].name, bones[i].name);
+	}
+	std::vector<CookedMaterial> mats;
+	std::vector<uint16_t> wstrings;
+	CookedMesh::PackMaterials(src.materials, mats, wstrings);
+
+	CookedFile::Blob blob;
+	blob.Append(nullptr, sizeof(CookedSkelHeader));
+	CookedSkelHeader h;
+	h.magic = kSkelMagic;
+	h.version = kVersion;
+	h.source = stamp;
+	h.skinned = src.skinned ? 1u : 0u;
+	h.nodeCount = (uint32_t)nodes.size();
+	h.boneCount = (uint32_t)bones.size();
+	h.partCount = (uint32_t)src.parts.size();
+	h.materialCount = (uint32_t)mats.size();
+	h.globalInv = src.globalInv;
+	h.nodeOffset = blob.AppendArray(nodes.data(), nodes.size());
+	h.boneOffset = blob.AppendArray(bones.data(), bones.size());
+	h.partOffset = blob.Append(nullptr, src.parts.size() * sizeof(CookedSkelPart)); // 아래에서 채움
+	h.materialOffset = blob.AppendArray(mats.data(), mats.size());
+	h.wstringOffset = blob.AppendArray(wstrings.data(), wstrings.size());
+	h.wstringCount = wstrings.size();
+	h.nameOffset = blob.Append(names.data(), names.size());
+	h.nameBytes = names.size();
+
+	for (size_t i = 0; i < src.parts.size(); ++i) {
+		const SkeletonCPU::Part& sp = src.parts[i];
+		CookedSkelPart cp;
+		cp.ownerNode = sp.ownerNode;
+		cp.materialIndex = sp.materialIndex;
+		if (src.skinned) {
+			cp.vertexCount = (uint32_t)sp.skinnedVertices.size();
+			cp.vertexOffset = blob.AppendArray(sp.skinnedVertices.data(), sp.skinnedVertices.size());
+		}
+		else {
+			cp.vertexCount = (uint32_t)sp.rigidVertices.size();
+			cp.vertexOffset = blob.AppendArray(sp.rigidVertices.data(), sp.rigidVertices.size());
+		}
+		cp.indexCount = (uint32_t)sp.indices.size();
+		cp.indexOffset = blob.AppendArray(sp.indices.data(), sp.indices.size());
+		cp.boneBoxCount = (uint32_t)sp.boneBoxes.size();
+		cp.boneBoxOffset = blob.AppendArray(sp.boneBoxes.data(), sp.boneBoxes.size());
+		blob.At<CookedSkelPart>(h.partOffset + i * sizeof(CookedSkelPart)) = cp;
+	}
+
+	h.fileSize = blob.Align(16);
+	blob.At<CookedSkelHeader>(0) = h;
+	return CookedFile::WriteFileAtomic(path, blob.bytes.data(), blob.bytes.size());
+}
+
+bool CookedSkeleton::OpenSkel(const std::wstring& path, const SourceStamp* expect, bool skinned, SkeletonCPU& out)
+{
+	MappedFile f;
+	if (!f.Open(path)) return false;
+
+	const CookedSkelHeader* h = CookedFile::Section<CookedSkelHeader>(f, 0, 1);
+	if (!h || h->magic != kSkelMagic || h->version != kVersion || h->fileSize != f.Size()) return false;
+	if ((expect && h->source != *expect) || h->skinned != (skinned ? 1u : 0u)) return false;
+
+	const CookedSkelNode* nodes = CookedFile::Section<CookedSkelNode>(f, h->nodeOffset, h->nodeCount);
+	const CookedSkelBone* bones = CookedFile::Section<CookedSkelBone>(f, h->boneOffset, h->boneCount);
+	const CookedSkelPart* parts = CookedFile::Section<CookedSkelPart>(f, h->partOffset, h->partCount);
+	const CookedMaterial* mats = CookedFile::Section<CookedMaterial>(f, h->materialOffset, h->materialCount);
+	const uint16_t* wstrings = CookedFile::Section<uint16_t>(f, h->wstringOffset, h->wstringCount);
+	const char* names = CookedFile::Section<char>(f, h->nameOffset, h->nameBytes);
+	if (!nodes || !bones || !parts || !mats || !wstrings || !names) return false;
+
+	SkeletonCPU s;
+	s.skinned = skinned;
+	s.globalInv = h->globalInv;
+
+	s.nodes.resize(h->nodeCount);
+	for (uint32_t i = 0; i < h->nodeCount; ++i) {
+		SkeletonCPU::Node& n = s.nodes[i];
+		n.parent = nodes[i].parent;
+		n.bindLocal = nodes[i].bindLocal;
+		// 위상 순서 (부모 < 자식, 루트 -1)가 깨졌으면 손상
+		if (n.parent < -1 || n.parent >= (int)i || !GetName(names, h->nameBytes, nodes[i].name, n.name)) return false;
+	}
+	s.bones.resize(h->boneCount);
+	for (uint32_t i = 0; i < h->boneCount; ++i) {
+		SkeletonCPU::Bone& b = s.bones[i];
+		b.node = bones[i].node;
+		b.offset = bones[i].offset;
+		if (b.node < 0 || b.node >= (int)h->nodeCount || !GetName(names, h->nameBytes, bones[i].name, b.name)) return false;
+	}
+	if (!CookedMesh::UnpackMaterials(mats, h->materialCount, wstrings, h->wstringCount, s.materials)) return false;
+
+	s.parts.resize(h->partCount);
+	for (uint32_t i = 0; i < h->partCount; ++i) {
+		const CookedSkelPart& cp = parts[i];
+		SkeletonCPU::Part& p = s.parts[i];
+		p.ownerNode = cp.ownerNode;
+		p.materialIndex = cp.materialIndex;
+		if (p.ownerNode < 0 || p.ownerNode >= (int)h->nodeCount || p.materialIndex >= h->materialCount) return false;
+
+		const bool ok = (skinned
+			? CopySection(f, cp.vertexOffset, cp.vertexCount, p.skinnedVertices)
+			: CopySection(f, cp.vertexOffset, cp.vertexCount, p.rigidVertices))
+			&& CopySection(f, cp.indexOffset, cp.indexCount, p.indices)
+			&& CopySection(f, cp.boneBoxOffset, cp.boneBoxCount, p.boneBoxes);
+		if (!ok) return false;
+
+		// 본 인덱스는 팔레트 범위 안 (CpuSkinning / 셰이더 / ComputeBounds가 범위 검사를 안 한다)
+		for (const VertexCPU_PNTT_BW& v : p.skinnedVertices) {
+			for (int k = 0; k < 4; ++k)
+				if (v.bi[k] >= h->boneCount) return false;
+		}
+		for (const SK_BoneBox& bb : p.boneBoxes)
+			if (bb.bone >= h->boneCount) return false;
+	}
+
+	out = std::move(s);
+	return true;
+}
+
+// ===== .anim =====
+bool CookedSkeleton::WriteAnim(const std::wstring& path, const AnimClipLibrary& lib, const SourceStamp& stamp)
+{
+	std::string names;
+	CookedFile::Blob blob;
+	blob.Append(nullptr, sizeof(CookedAnimHeader));
+	CookedAnimHeader h;
+	h.magic = kAnimMagic;
+	h.version = kVersion;
+	h.source = stamp;
+	h.clipCount = (uint32_t)lib.Count();
+	h.clipOffset = blob.Append(nullptr, lib.Count() * sizeof(CookedClip));
+
+	for (size_t i = 0; i < lib.Count(); ++i) {
+		const AnimClip& c = *lib.Get(i);
+		CookedClip cc;
+		PutName(names, c.name, cc.name);
+		cc.duration = c.duration;
+		cc.ticksPerSec = c.ticksPerSec;
+		cc.keyRate = c.keyRate;
+		cc.posMin[0] = c.posMin.x; cc.posMin[1] = c.posMin.y; cc.posMin[2] = c.posMin.z;
+		cc.posStep[0] = c.posStep.x; cc.posStep[1] = c.posStep.y; cc.posStep[2] = c.posStep.z;
+
+		std::vector<CookedChannel> channels(c.channels.size());
+		for (size_t k = 0; k < c.channels.size(); ++k) {
+			PutName(names, c.channels[k].target, channels[k].target);
+			channels[k].T = c.channels[k].T;
+			channels[k].R = c.channels[k].R;
+			channels[k].S = c.channels[k].S;
+		}
+		const std::vector<int32_t> nodeChannel(c.nodeChannel.begin(), c.nodeChannel.end());
+
+		cc.channelCount = (uint32_t)channels.size();
+		cc.nodeCount = (uint32_t)nodeChannel.size();
+		cc.timeCount = (uint32_t)c.times.size();
+		cc.rotCount = (uint32_t)c.rots.size();
+		cc.posCount = (uint32_t)c.poss.size();
+		cc.scaleCount = (uint32_t)c.scales.size();
+		cc.channelOffset = blob.AppendArray(channels.data(), channels.size());
+		cc.nodeChannelOffset = blob.AppendArray(nodeChannel.data(), nodeChannel.size());
+		cc.timeOffset = blob.AppendArray(c.times.data(), c.times.size());
+		cc.rotOffset = blob.AppendArray(c.rots.data(), c.rots.size());
+		cc.posOffset = blob.AppendArray(c.poss.data(), c.poss.size());
+		cc.scaleOffset = blob.AppendArray(c.scales.data(), c.scales.size());
+
+		cc.rawKeys = c.stats.rawKeys;
+		cc.keptKeys = c.stats.keptKeys;
+		cc.rawBytes = c.stats.rawBytes;
+		cc.packedBytes = c.stats.packedBytes;
+		cc.maxErrT = c.stats.maxErrT;
+		cc.maxErrRDeg = c.stats.maxErrRDeg;
+		cc.maxErrS = c.stats.maxErrS;
+		blob.At<CookedClip>(h.clipOffset + i * sizeof(CookedClip)) = cc;
+	}
+
+	h.nameOffset = blob.Append(names.data(), names.size());
+	h.nameBytes = names.size();
+	h.fileSize = blob.Align(16);
+	blob.At<CookedAnimHeader>(0) = h;
+	return CookedFile::WriteFileAtomic(path, blob.bytes.data(), blob.bytes.size());
+}
+
+std::shared_ptr<const AnimClipLibrary> CookedSkeleton::OpenAnim(const std::wstring& path, const SourceStamp* expect)
+{
+	MappedFile f;
+	if (!f.Open(path)) return nullptr;
+
+	const CookedAnimHeader* h = CookedFile::Section<CookedAnimHeader>(f, 0, 1);
+	if (!h || h->magic != kAnimMagic || h->version != kVersion || h->fileSize != f.Size()) return nullptr;
+	if (expect && h->source != *expect) return nullptr;
+
+	const CookedClip* clips = CookedFile::Section<CookedClip>(f, h->clipOffset, h->clipCount);
+	const char* names = CookedFile::Section<char>(f, h->nameOffset, h->nameBytes);
+	if (!clips || !names) return nullptr;
+
+	std::vector<AnimClip> out(h->clipCount);
+	for (uint32_t i = 0; i < h->clipCount; ++i) {
+		const CookedClip& cc = clips[i];
+		AnimClip& c = out[i];
+		if (!GetName(names, h->nameBytes, cc.name, c.name)) return nullptr;
+		c.duration = cc.duration;
+		c.ticksPerSec = cc.ticksPerSec;
+		c.keyRate = cc.keyRate;
+		c.posMin = DirectX::XMFLOAT3(cc.posMin);
+		c.posStep = DirectX::XMFLOAT3(cc.posStep);
+
+		const CookedChannel* channels = CookedFile::Section<CookedChannel>(f, cc.channelOffset, cc.channelCount);
+		std::vector<int32_t> nodeChannel;
+		const bool ok = channels
+			&& CopySection(f, cc.nodeChannelOffset, cc.nodeCount, nodeChannel)
+			&& CopySection(f, cc.timeOffset, cc.timeCount, c.times)
+			&& CopySection(f, cc.rotOffset, cc.rotCount, c.rots)
+			&& CopySection(f, cc.posOffset, cc.posCount, c.poss)
+			&& CopySection(f, cc.scaleOffset, cc.scaleCount, c.scales);
+		if (!ok) return nullptr;
+
+		// 트랙 구간이 키 배열 밖을 가리키면 손상 (샘플러는 범위 검사를 하지 않는다)
+		auto trackOk = [&](const AnimTrack& t, size_t values) {
+			if (t.count == 0) return true;
+			if ((uint64_t)t.valueOffset + t.count > values) return false;
+			return c.keyRate > 0.0f || (uint64_t)t.timeOffset + t.count <= c.times.size();
+			};
+		c.channels.resize(cc.channelCount);
+		for (uint32_t k = 0; k < cc.channelCount; ++k) {
+			AnimChannel& ch = c.channels[k];
+			ch.T = channels[k].T;
+			ch.R = channels[k].R;
+			ch.S = channels[k].S;
+			if (!GetName(names, h->nameBytes, channels[k].target, ch.target)) return nullptr;
+			if (!trackOk(ch.T, c.poss.size()) || !trackOk(ch.R, c.rots.size()) || !trackOk(ch.S, c.scales.size()))
+				return nullptr;
+		}
+		c.nodeChannel.resize(nodeChannel.size());
+		for (size_t n = 0; n < nodeChannel.size(); ++n) {
+			if (nodeChannel[n] < -1 || nodeChannel[n] >= (int32_t)cc.channelCount) return nullptr;
+			c.nodeChannel[n] = nodeChannel[n];
+		}
+
+		c.stats.rawKeys = cc.rawKeys;
+		c.stats.keptKeys = cc.keptKeys;
+		c.stats.rawBytes = (size_t)cc.rawBytes;
+		c.stats.packedBytes = (size_t)cc.packedBytes;
+		c.stats.maxErrT = cc.maxErrT;
+		c.stats.maxErrRDeg = cc.maxErrRDeg;
+		c.stats.maxErrS = cc.maxErrS;
+	}
+	return AnimClipLibrary::FromClips(std::move(out));
+}
+
+// ===== 로드 또는 쿡 =====
+bool CookedSkeleton::LoadOrCook(const std::wstring& fbxPath, bool skinned, const AnimCompressSettings& cs,
+	SkeletonCPU& out, bool* wasCooked, bool loadClips)
+{
+	if (wasCooked) *wasCooked = false;
+	const std::wstring skelPath = SkelPath(fbxPath, skinned);
+	const std::wstring animPath = AnimPath(fbxPath);
+
+	SourceStamp skelStamp;
+	const bool haveSource = CookedFile::StampSource(fbxPath, SkelOptions(skinned), skelStamp);
+	SourceStamp animStamp = skelStamp;
+	animStamp.options = AnimOptions(cs);
+
+	// 원본이 없으면 (배포본 등) 쿡 파일만으로
+	if (OpenSkel(skelPath, haveSource ? &skelStamp : nullptr, skinned, out)) {
+		if (!loadClips) {
+			out.clips = nullptr;
+			if (wasCooked) *wasCooked = true;
+			return true;
+		}
+		// 원본이 없으면 두 파일을 묶어 주는 스탬프가 없다 -> 클립의 노드 수가 스켈레톤과 같은지 직접 본다
+		// (SampleLocalPose는 nodeChannel 길이만큼 스켈레톤 크기의 포즈 배열에 쓴다)
+		if (auto clips = OpenAnim(animPath, haveSource ? &animStamp : nullptr)) {
+			bool match = true;
+			for (size_t i = 0; match && i < clips->Count(); ++i)
+				match = clips->Get(i)->nodeChannel.size() == out.nodes.size();
+			if (match) {
+				out.clips = std::move(clips);
+				if (wasCooked) *wasCooked = true;
+				return true;
+			}
+		}
+	}
+	if (!haveSource) return false;
+
+	// stale/없음 -> Assimp (쓰기 실패는 무시: 다음 실행에 다시 쿡)
+	SkeletonImport::FromFBX(fbxPath, skinned, cs, out, WorkerPool::DefaultWorkers());
+	WriteSkel(skelPath, out, skelStamp);
+	WriteAnim(animPath, *out.clips, animStamp);
+	return true;
+}
@@ -0,0 +1,124 @@
+﻿// CookedSkeleton.h
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <DirectXMath.h>
+
+#include "CookedFile.h"
+#include "CookedMesh.h"
+#include "SkeletonImport.h"
+
+//================================================================================================
+// 쿡된 스켈레톤 (.skel) + 클립 (.anim) — RigidSkeletal / SkeletonAsset 공용
+//  - .skel : [헤더][노드 (부모, 이름, bindLocal)][본 (노드, 이름, inverse bind)][파트 (소유 노드, 머티리얼,
+//            정점/인덱스/본 박스 구간)][머티리얼][UTF-16 파일명][UTF-8 이름][파트 데이터...]
+//  - .anim : [헤더][클립 (메타 + 구간)][채널][nodeChannel][times][rots][poss][scales][UTF-8 이름]
+//  - 모든 참조는 파일 시작 기준 오프셋 (재배치 불필요), 섹션 16바이트 정렬, 리틀 엔디언.
+//  - 로드는 매핑 후 섹션마다 한 번씩 통째로 복사 (노드/클립 구조는 로더가 소유하는 vector 그대로).
+//  - stale 판정: .skel = 원본 스탬프 + rigid/skinned, .anim = 원본 스탬프 + AnimCompressSettings.
+//    둘 중 하나라도 맞지 않으면 Assimp로 다시 임포트해서 둘 다 새로 쓴다.
+//  - .anim은 노드 순서가 같은 rigid/skinned 로더가 같이 쓴다 (FBX당 하나).
+//================================================================================================
+struct CookedSkelHeader
+{
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    SourceStamp source;
+    uint64_t fileSize = 0;
+
+    uint32_t skinned = 0, nodeCount = 0, boneCount = 0, partCount = 0, materialCount = 0, pad = 0;
+    DirectX::XMFLOAT4X4 globalInv;
+
+    uint64_t nodeOffset = 0, boneOffset = 0, partOffset = 0, materialOffset = 0;
+    uint64_t wstringOffset = 0, wstringCount = 0;   // 머티리얼 파일명 (char16 단위)
+    uint64_t nameOffset = 0, nameBytes = 0;         // 노드/본 이름
+};
+
+struct CookedSkelNode
+{
+    int32_t parent = -1;
+    uint32_t name[2] = {};          // 이름 섹션의 (시작, 길이)
+    uint32_t pad = 0;
+    DirectX::XMFLOAT4X4 bindLocal;
+};
+
+struct CookedSkelBone
+{
+    int32_t node = -1;
+    uint32_t name[2] = {};
+    uint32_t pad = 0;
+    DirectX::XMFLOAT4X4 offset;
+};
+
+struct CookedSkelPart
+{
+    int32_t ownerNode = -1;
+    uint32_t materialIndex = 0;
+    uint32_t vertexCount = 0, indexCount = 0, boneBoxCount = 0, pad = 0;
+    uint64_t vertexOffset = 0, indexOffset = 0, boneBoxOffset = 0; // 정점은 skinned면 VertexCPU_PNTT_BW
+};
+
+struct CookedAnimHeader
+{
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    SourceStamp source;
+    uint64_t fileSize = 0;
+
+    uint32_t clipCount = 0, pad = 0;
+    uint64_t clipOffset = 0, nameOffset = 0, nameBytes = 0;
+};
+
+struct CookedClip
+{
+    uint32_t name[2] = {};
+    double duration = 0.0, ticksPerSec = 0.0;
+    float keyRate = 0.0f;
+    float posMin[3] = {}, posStep[3] = {};
+    uint32_t pad = 0;
+
+    uint32_t channelCount = 0, nodeCount = 0, timeCount = 0, rotCount = 0, posCount = 0, scaleCount = 0;
+    uint64_t channelOffset = 0, nodeChannelOffset = 0, timeOffset = 0, rotOffset = 0, posOffset = 0, scaleOffset = 0;
+
+    // AnimCompressStats
+    uint32_t rawKeys = 0, keptKeys = 0;
+    uint64_t rawBytes = 0, packedBytes = 0;
+    float maxErrT = 0.0f, maxErrRDeg = 0.0f, maxErrS = 0.0f, pad2 = 0.0f;
+};
+
+struct CookedChannel
+{
+    uint32_t target[2] = {};
+    AnimTrack T, R, S;
+};
+
+namespace CookedSkeleton
+{
+    constexpr uint32_t kSkelMagic = 0x4C454B53; // "SKEL"
+    constexpr uint32_t kAnimMagic = 0x4D494E41; // "ANIM"
+    constexpr uint32_t kVersion = 1;
+
+    // 원본 옆 쿡 파일 경로: skinned "X.skel" / rigid "X.rigid.skel", 클립 "X.anim"
+    std::wstring SkelPath(const std::wstring& fbxPath, bool skinned);
+    std::wstring AnimPath(const std::wstring& fbxPath);
+
+    // SourceStamp::options
+    uint32_t SkelOptions(bool skinned);
+    uint32_t AnimOptions(const AnimCompressSettings& cs);
+
+    bool WriteSkel(const std::wstring& path, const SkeletonCPU& src, const SourceStamp& stamp);
+    bool WriteAnim(const std::wstring& path, const AnimClipLibrary& clips, const SourceStamp& stamp);
+
+    // expect == nullptr : 원본 없이 쿡 파일만 믿고 연다. 실패(없음/불일치/손상)하면 false / nullptr
+    bool OpenSkel(const std::wstring& path, const SourceStamp* expect, bool skinned, SkeletonCPU& out);
+    std::shared_ptr<const AnimClipLibrary> OpenAnim(const std::wstring& path, const SourceStamp* expect);
+
+    // .skel/.anim이 둘 다 유효하면 읽고, 아니면 SkeletonImport::FromFBX 후 둘 다 다시 쓴다.
+    // 클립의 노드 수가 .skel과 다르면 (원본 없이 서로 다른 쿡 결과가 섞인 경우 등) .anim은 무효.
+    // loadClips == false : 클립 라이브러리가 이미 캐시에 있음. .anim은 열지 않고 out.clips는 비워 둔다
+    //                      (.skel이 stale이라 임포트하게 되면 그때 만든 클립은 채워진다)
+    // 원본도 쿡 파일도 없으면 false. 임포트 실패는 std::runtime_error
+    bool LoadOrCook(const std::wstring& fbxPath, bool skinned, const AnimCompressSettings& cs,
+        SkeletonCPU& out, bool* wasCooked = nullptr, bool loadClips = true);
+}
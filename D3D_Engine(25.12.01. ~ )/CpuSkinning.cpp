@@ -0,0 +1,161 @@
+﻿// CpuSkinning.cpp
+// (pch 없이 빌드: 리눅스 단독 컴파일용)
+#include "CpuSkinning.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CPUSKIN_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define CPUSKIN_TARGET_AVX2
+#else
+#define CPUSKIN_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace CpuSkinning
+{
+	// 본당 float 12개: 행 r0(0..3), r1(4..7), r2(8..11). out_k = dot(r_k, (p, 1))
+	static constexpr int kBoneFloats = 12;
+
+	// ===== 스칼라 (기준) =====
+	static void SkinScalar(const VertexCPU_PNTT_BW* in, size_t count, const float* pal, SkinnedVertex* out)
+	{
+		for (size_t i = 0; i < count; ++i) {
+			const VertexCPU_PNTT_BW& v = in[i];
+
+			// 셰이더와 같은 순서: 4본 가중 합 -> 곱
+			float B[kBoneFloats] = {};
+			for (int k = 0; k < 4; ++k) {
+				const float w = v.bw[k];
+				const float* m = pal + size_t(v.bi[k]) * kBoneFloats;
+				for (int c = 0; c < kBoneFloats; ++c) B[c] += w * m[c];
+			}
+
+			SkinnedVertex& o = out[i];
+			o.px = B[0] * v.px + B[1] * v.py + B[2] * v.pz + B[3];
+			o.py = B[4] * v.px + B[5] * v.py + B[6] * v.pz + B[7];
+			o.pz = B[8] * v.px + B[9] * v.py + B[10] * v.pz + B[11];
+			o.nx = B[0] * v.nx + B[1] * v.ny + B[2] * v.nz;
+			o.ny = B[4] * v.nx + B[5] * v.ny + B[6] * v.nz;
+			o.nz = B[8] * v.nx + B[9] * v.ny + B[10] * v.nz;
+			o.tx = B[0] * v.tx + B[1] * v.ty + B[2] * v.tz;
+			o.ty = B[4] * v.tx + B[5] * v.ty + B[6] * v.tz;
+			o.tz = B[8] * v.tx + B[9] * v.ty + B[10] * v.tz;
+			o.tw = v.tw;
+		}
+	}
+
+#if defined(CPUSKIN_X86)
+	// ===== AVX2: 8정점 SoA =====
+	// 정점 성분은 stride gather로 SoA로 모으고, 본 행도 lane별 본 인덱스로 gather.
+	// 결과는 SoA 임시 버퍼에 쓰고 AoS로 풀어 저장 (AVX2에는 scatter가 없다).
+	CPUSKIN_TARGET_AVX2
+	static void SkinAVX2(const VertexCPU_PNTT_BW* in, size_t count, const float* pal, SkinnedVertex* out)
+	{
+		static_assert(sizeof(VertexCPU_PNTT_BW) % sizeof(float) == 0, "vertex stride must be whole floats");
+		constexpr int kStride = int(sizeof(VertexCPU_PNTT_BW) / sizeof(float));
+		constexpr int kBI = int(offsetof(VertexCPU_PNTT_BW, bi) / sizeof(float)); // bi[0..1], bi[2..3] = dword 2개
+		constexpr int kBW = int(offsetof(VertexCPU_PNTT_BW, bw) / sizeof(float));
+
+		const __m256i vtx = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(kStride));
+		const __m256i lo16 = _mm256_set1_epi32(0xFFFF);
+		const __m256i boneFloats = _mm256_set1_epi32(kBoneFloats);
+
+		alignas(32) float soa[10][8];
+		const size_t n8 = count & ~size_t(7);
+		for (size_t i = 0; i < n8; i += 8) {
+			const float* base = reinterpret_cast<const float*>(in + i);
+#define CPUSKIN_GATHER(off) _mm256_i32gather_ps(base + (off), vtx, 4)
+			const __m256 px = CPUSKIN_GATHER(0), py = CPUSKIN_GATHER(1), pz = CPUSKIN_GATHER(2);
+			const __m256 nx = CPUSKIN_GATHER(3), ny = CPUSKIN_GATHER(4), nz = CPUSKIN_GATHER(5);
+			const __m256 tx = CPUSKIN_GATHER(8), ty = CPUSKIN_GATHER(9), tz = CPUSKIN_GATHER(10);
+			const __m256 w[4] = { CPUSKIN_GATHER(kBW), CPUSKIN_GATHER(kBW + 1), CPUSKIN_GATHER(kBW + 2), CPUSKIN_GATHER(kBW + 3) };
+			_mm256_store_ps(soa[9], CPUSKIN_GATHER(11));
+#undef CPUSKIN_GATHER
+
+			// uint16 x4 -> 본 행 시작 오프셋(float 단위) x4
+			const __m256i bi01 = _mm256_i32gather_epi32(reinterpret_cast<const int*>(base + kBI), vtx, 4);
+			const __m256i bi23 = _mm256_i32gather_epi32(reinterpret_cast<const int*>(base + kBI + 1), vtx, 4);
+			const __m256i b[4] = {
+				_mm256_mullo_epi32(_mm256_and_si256(bi01, lo16), boneFloats),
+				_mm256_mullo_epi32(_mm256_srli_epi32(bi01, 16), boneFloats),
+				_mm256_mullo_epi32(_mm256_and_si256(bi23, lo16), boneFloats),
+				_mm256_mullo_epi32(_mm256_srli_epi32(bi23, 16), boneFloats),
+			};
+
+			for (int r = 0; r < 3; ++r) {
+				const float* row = pal + r * 4;
+				__m256 c0 = _mm256_setzero_ps(), c1 = c0, c2 = c0, c3 = c0;
+				for (int k = 0; k < 4; ++k) {
+					c0 = _mm256_add_ps(c0, _mm256_mul_ps(w[k], _mm256_i32gather_ps(row + 0, b[k], 4)));
+					c1 = _mm256_add_ps(c1, _mm256_mul_ps(w[k], _mm256_i32gather_ps(row + 1, b[k], 4)));
+					c2 = _mm256_add_ps(c2, _mm256_mul_ps(w[k], _mm256_i32gather_ps(row + 2, b[k], 4)));
+					c3 = _mm256_add_ps(c3, _mm256_mul_ps(w[k], _mm256_i32gather_ps(row + 3, b[k], 4)));
+				}
+				const __m256 p = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c0, px), _mm256_mul_ps(c1, py)),
+					_mm256_add_ps(_mm256_mul_ps(c2, pz), c3));
+				const __m256 n = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c0, nx), _mm256_mul_ps(c1, ny)), _mm256_mul_ps(c2, nz));
+				const __m256 t = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c0, tx), _mm256_mul_ps(c1, ty)), _mm256_mul_ps(c2, tz));
+				_mm256_store_ps(soa[r], p);
+				_mm256_store_ps(soa[3 + r], n);
+				_mm256_store_ps(soa[6 + r], t);
+			}
+
+			for (int l = 0; l < 8; ++l) {
+				SkinnedVertex& o = out[i + l];
+				o.px = soa[0][l]; o.py = soa[1][l]; o.pz = soa[2][l];
+				o.nx = soa[3][l]; o.ny = soa[4][l]; o.nz = soa[5][l];
+				o.tx = soa[6][l]; o.ty = soa[7][l]; o.tz = soa[8][l]; o.tw = soa[9][l];
+			}
+		}
+
+		// 나머지 (8 미만)
+		SkinScalar(in + n8, count - n8, pal, out + n8);
+	}
+#endif
+
+	bool HasAVX2()
+	{
+#if defined(CPUSKIN_X86)
+		static const bool s_avx2 = [] {
+#if defined(_MSC_VER)
+			int r[4];
+			__cpuid(r, 0);
+			if (r[0] < 7) return false;
+			__cpuid(r, 1);
+			const bool osxsave = (r[2] & (1 << 27)) != 0;
+			const bool avx = (r[2] & (1 << 28)) != 0;
+			if (!osxsave || !avx) return false;
+			if ((_xgetbv(0) & 0x6) != 0x6) return false; // OS가 YMM 상태를 저장하는지
+			__cpuidex(r, 7, 0);
+			return (r[1] & (1 << 5)) != 0;
+#else
+			return __builtin_cpu_supports("avx2") != 0;
+#endif
+			}();
+		return s_avx2;
+#else
+		return false;
+#endif
+	}
+
+	const char* ToString(Kernel k)
+	{
+		return (k == Kernel::AVX2) ? "AVX2" : "Scalar";
+	}
+
+	void Skin(Kernel k, const VertexCPU_PNTT_BW* in, size_t count, const float* palette, SkinnedVertex* out)
+	{
+#if defined(CPUSKIN_X86)
+		if (k == Kernel::AVX2 && HasAVX2()) { SkinAVX2(in, count, palette, out); return; }
+#endif
+		(void)k;
+		SkinScalar(in, count, palette, out);
+	}
+
+	void Skin(const VertexCPU_PNTT_BW* in, size_t count, const float* palette, SkinnedVertex* out)
+	{
+		Skin(HasAVX2() ? Kernel::AVX2 : Kernel::Scalar, in, count, palette, out);
+	}
+}
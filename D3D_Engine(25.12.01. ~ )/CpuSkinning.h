@@ -0,0 +1,36 @@
+﻿// CpuSkinning.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "MeshDataEx.h"
+
+//================================================================================================
+// CPU 기준 스키닝 — VertexShaderSkinning.hlsl (Shared.hlsli SkinMatrix)와 같은 수식
+//  - 입력: VertexCPU_PNTT_BW + 3x4 팔레트. 팔레트는 본당 float 12개 (행 r0, r1, r2)로
+//    PoseMath::BoneMatrix / PoseInstance::palette / BakedClip::Palette와 메모리 배치가 같다.
+//  - 출력: 모델 공간 위치/노멀/탄젠트. 셰이더처럼 노멀/탄젠트는 정규화하지 않는다.
+//  - x86이고 CPU가 AVX2를 지원하면 8정점씩 SoA 커널, 아니면 스칼라. (런타임 판별)
+//  - D3D/DirectXMath/pch 의존 없음: 리눅스에서도 이 파일 둘만으로 빌드된다.
+//  - 전제: 모든 bi[k] < boneCount (로더가 보장). 범위 검사는 하지 않는다.
+//================================================================================================
+namespace CpuSkinning
+{
+	struct SkinnedVertex
+	{
+		float px, py, pz;
+		float nx, ny, nz;
+		float tx, ty, tz, tw; // tw(handedness)는 그대로 통과
+	};
+
+	enum class Kernel { Scalar, AVX2 };
+
+	// 가장 빠른 커널로 스키닝
+	void Skin(const VertexCPU_PNTT_BW* in, size_t count, const float* palette, SkinnedVertex* out);
+
+	// 커널 지정 (AVX2를 못 쓰는 CPU면 Scalar로 내려간다). 정확도/속도 비교용
+	void Skin(Kernel k, const VertexCPU_PNTT_BW* in, size_t count, const float* palette, SkinnedVertex* out);
+
+	bool HasAVX2();
+	const char* ToString(Kernel k);
+}
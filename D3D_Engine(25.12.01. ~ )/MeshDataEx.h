@@ -16,10 +16,25 @@ struct VertexCPU_PNTT_BW {
 	float nx, ny, nz;
 	float u, v;
 	float tx, ty, tz, tw; // handedness
-	uint8_t  bi[4];       // Bone indices (0~255)
+	uint16_t bi[4];       // Bone indices (0~65535, 팔레트 StructuredBuffer 기준)
 	float    bw[4];       // Bone weights (정규화)
 };
 
+// GPU 스킨 정점 (36B = VertexCPU_PNTT_BW 72B의 절반). SkinnedMesh::Build가 VertexCPU_PNTT_BW에서 변환.
+//  - 노멀: octahedral, SNORM16 x2
+//  - 탄젠트: octahedral, x 16bit / y 15bit + 최하위 1bit = handedness (1이면 w = -1)
+//  - UV: half x2, 가중치: UNORM8 x4 (합이 정확히 255가 되게 보정)
+//  - 본 인덱스는 16bit 그대로 (공용 팔레트 오프셋 구조라 256본 제한을 두지 않는다)
+struct VertexGPU_Skinned {
+	float    px, py, pz;  //  0 R32G32B32_FLOAT    POSITION
+	int16_t  n[2];        // 12 R16G16_SNORM       NORMAL
+	uint16_t t[2];        // 16 R16G16_UINT        TANGENT
+	uint16_t uv[2];       // 20 R16G16_FLOAT       TEXCOORD0
+	uint16_t bi[4];       // 24 R16G16B16A16_UINT  BLENDINDICES
+	uint8_t  bw[4];       // 32 R8G8B8A8_UNORM     BLENDWEIGHT
+};
+static_assert(sizeof(VertexGPU_Skinned) == 36, "VertexGPU_Skinned must match the skinned input layouts");
+
 struct SubMeshCPU {
 	uint32_t baseVertex = 0, indexStart = 0, indexCount = 0, materialIndex = 0;
 };
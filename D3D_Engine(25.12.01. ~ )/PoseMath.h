@@ -0,0 +1,157 @@
+﻿// PoseMath.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+#if __has_include(<directxtk/SimpleMath.h>)
+#include <directxtk/SimpleMath.h>
+#define POSEMATH_SIMPLEMATH 1
+#endif
+
+// =========================================================
+// 계층 포즈 계산 (RigidSkeletal / SkinnedSkeletal 공용)
+//  - 노드는 위상 순서(부모가 항상 자식보다 앞)로 저장되어 있다는 전제.
+//    parents[i] < i, 루트는 -1. (로더가 DFS로 노드를 쌓으므로 자동으로 만족)
+//  - 재귀/std::function 없이 한 번의 선형 루프, 곱셈은 XMMatrixMultiply(SIMD).
+// =========================================================
+namespace PoseMath
+{
+#if defined(POSEMATH_SIMPLEMATH)
+	using Matrix = DirectX::SimpleMath::Matrix;
+#else
+	// DirectXTK 없는 빌드 (오프라인 쿠커). 여기 함수들은 Load/Store만 하므로 배치가 같은 XMFLOAT4X4로 충분
+	using Matrix = DirectX::XMFLOAT4X4;
+#endif
+
+	// 로컬 포즈 TRS (블렌딩 가능한 형태). 회전은 16B 정렬 쿼터니언.
+	struct PoseTRS
+	{
+		DirectX::XMFLOAT4A r{ 0.0f, 0.0f, 0.0f, 1.0f };
+		DirectX::XMFLOAT3  t{ 0.0f, 0.0f, 0.0f };
+		DirectX::XMFLOAT3  s{ 1.0f, 1.0f, 1.0f };
+	};
+
+	// 스키닝 팔레트 한 칸: affine 3x4 (48B, 4x4보다 25% 작다).
+	// 행 k = 행 벡터 규약 4x4의 k번째 열 (XMStoreFloat3x4가 전치해서 저장). 4번째 열 (0,0,0,1)은 버린다.
+	// HLSL: float3x4(r0, r1, r2)로 읽어 mul(B, float4(p, 1)).
+	using BoneMatrix = DirectX::XMFLOAT3X4;
+
+	inline BoneMatrix BoneIdentity()
+	{
+		BoneMatrix m;
+		DirectX::XMStoreFloat3x4(&m, DirectX::XMMatrixIdentity());
+		return m;
+	}
+
+	// out = lerp(a, b, t), float4 행 rows개 (행 하나 SIMD). 인접 프레임 사이라 행렬 lerp로 충분.
+	inline void LerpRows(const float* a, const float* b, float t, float* out, size_t rows)
+	{
+		using namespace DirectX;
+		for (size_t r = 0; r < rows; ++r) {
+			const XMVECTOR A = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(a + 4 * r));
+			const XMVECTOR B = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(b + 4 * r));
+			XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(out + 4 * r), XMVectorLerp(A, B, t));
+		}
+	}
+
+	// 팔레트 n칸 (3x4 = 행 3개씩)
+	inline void LerpBones(const BoneMatrix* a, const BoneMatrix* b, float t, BoneMatrix* out, size_t n)
+	{
+		LerpRows(&a->m[0][0], &b->m[0][0], t, &out->m[0][0], n * 3);
+	}
+
+	// 4x4 행렬 n개 (행 4개씩)
+	inline void LerpMatrices(const Matrix* a, const Matrix* b, float t, Matrix* out, size_t n)
+	{
+		LerpRows(&a->_11, &b->_11, t, &out->_11, n * 4);
+	}
+
+	// 바인드 로컬 행렬 -> TRS (로드 때 한 번)
+	inline PoseTRS DecomposeTRS(const Matrix& m)
+	{
+		using namespace DirectX;
+		XMVECTOR s, r, t;
+		PoseTRS p;
+		if (XMMatrixDecompose(&s, &r, &t, XMLoadFloat4x4(&m))) {
+			XMStoreFloat3(&p.s, s);
+			XMStoreFloat4A(&p.r, r);
+			XMStoreFloat3(&p.t, t);
+		}
+		else {
+			// 스케일 0 등 분해 불가: 이동만 살림
+			XMStoreFloat3(&p.t, XMLoadFloat4x4(&m).r[3]);
+		}
+		return p;
+	}
+
+	// S * R * T 를 행렬곱 없이 한 번에: 회전 행렬의 각 행에 스케일, 4행에 이동 (affine, 4열 = 0,0,0,1)
+	inline DirectX::XMMATRIX ComposeAffine(DirectX::FXMVECTOR s, DirectX::FXMVECTOR r, DirectX::FXMVECTOR t)
+	{
+		using namespace DirectX;
+		XMMATRIX M = XMMatrixRotationQuaternion(r);
+		M.r[0] = XMVectorScale(M.r[0], XMVectorGetX(s));
+		M.r[1] = XMVectorScale(M.r[1], XMVectorGetY(s));
+		M.r[2] = XMVectorScale(M.r[2], XMVectorGetZ(s));
+		M.r[3] = XMVectorSelect(g_XMIdentityR3, t, g_XMSelect1110);
+		return M;
+	}
+
+	inline DirectX::XMMATRIX ComposeAffine(const PoseTRS& p)
+	{
+		using namespace DirectX;
+		return ComposeAffine(XMLoadFloat3(&p.s), XMLoadFloat4A(&p.r), XMLoadFloat3(&p.t));
+	}
+
+	// TRS 로컬 포즈에서 바로: global[i] = Compose(local[i]) * global[parent]
+	inline void LocalToGlobal(const int* parents, size_t n,
+		const PoseTRS* local, Matrix* global)
+	{
+		using namespace DirectX;
+		for (size_t i = 0; i < n; ++i) {
+			const XMMATRIX L = ComposeAffine(local[i]);
+			const int p = parents[i];
+			XMStoreFloat4x4(&global[i], (p >= 0) ? XMMatrixMultiply(L, XMLoadFloat4x4(&global[p])) : L);
+		}
+	}
+
+	// 정적 서브트리 분리: 자신과 모든 조상에 채널이 없는 노드는 global이 바인드 포즈로 고정된다.
+	// animated[i] != 0 : 어떤 클립이든 노드 i에 채널이 있음. 반환 = 동적 노드 인덱스 (위상 순서 유지)
+	inline std::vector<int> DynamicNodes(const int* parents, size_t n, const uint8_t* animated)
+	{
+		std::vector<uint8_t> dyn(n, 0);
+		std::vector<int> out;
+		for (size_t i = 0; i < n; ++i) {
+			const int p = parents[i];
+			dyn[i] = animated[i] || (p >= 0 && dyn[p]);
+			if (dyn[i]) out.push_back((int)i);
+		}
+		return out;
+	}
+
+	// 동적 노드만 갱신. 정적 노드의 global은 미리 바인드 글로벌로 채워져 있어야 한다.
+	inline void LocalToGlobalSubset(const int* parents, const int* nodes, size_t count,
+		const PoseTRS* local, Matrix* global)
+	{
+		using namespace DirectX;
+		for (size_t k = 0; k < count; ++k) {
+			const int i = nodes[k];
+			const XMMATRIX L = ComposeAffine(local[i]);
+			const int p = parents[i];
+			XMStoreFloat4x4(&global[i], (p >= 0) ? XMMatrixMultiply(L, XMLoadFloat4x4(&global[p])) : L);
+		}
+	}
+
+	// 스키닝 팔레트: palette[i] = offset[i] * global[boneNodes[i]] (3x4 전치 저장, 4번째 열 버림).
+	// 본 이름 테이블은 안 보고 연속 배열 두 개만 읽는다.
+	inline void SkinPalette(const int* boneNodes, const Matrix* offsets, size_t n,
+		const Matrix* global, BoneMatrix* palette)
+	{
+		using namespace DirectX;
+		for (size_t i = 0; i < n; ++i) {
+			const XMMATRIX G = XMLoadFloat4x4(&global[boneNodes[i]]);             // model space
+			XMStoreFloat3x4(&palette[i], XMMatrixMultiply(XMLoadFloat4x4(&offsets[i]), G)); // skinning matrix
+		}
+	}
+}
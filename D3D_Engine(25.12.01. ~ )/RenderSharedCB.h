@@ -62,6 +62,16 @@ namespace RenderCB
 		Vector4 Params;  // x: compareBias, y: 1/width, z: 1/height, w: reserve
 	};
 
+	// =========================================================
+	// b4: 본 팔레트 시작 오프셋 (팔레트 본체는 VS t7 StructuredBuffer)
+	// HLSL: cbuffer Bones : register(b4)
+	// =========================================================
+	struct BoneBase
+	{
+		std::uint32_t base;     // BonePalette[base + index]
+		std::uint32_t pad[3];   // 16B 정렬
+	};
+
 	// =========================================================
 	// b7: ToonCB – Ramp/Toon 파라미터
 	// HLSL: cbuffer ToonCB : register(b7)
@@ -85,3 +95,4 @@ using BlinnPhongCB = RenderCB::BlinnPhong;
 using UseCB = RenderCB::Use;
 using ShadowCB = RenderCB::Shadow;
 using ToonCB_ = RenderCB::Toon;
+using BoneBaseCB = RenderCB::BoneBase;
@@ -13,8 +13,13 @@
 #include "AssimpImporterEX.h"
 #include "MeshDataEx.h"
 #include "StaticMesh.h"
+#include "CookedMesh.h"
 #include "SkinnedMesh.h"
 #include "Material.h"
+#include "AnimClip.h"
+#include "CookedSkeleton.h"
+#include "SkeletonAsset.h"
+#include "BakedClip.h"
 
 ResourceManager& ResourceManager::Instance()
 {
@@ -34,6 +39,9 @@ void ResourceManager::Shutdown()
 	m_texCache.clear();
 	m_staticCache.clear();
 	m_skinnedCache.clear();
+	m_skeletonCache.clear();
+	m_animCache.clear();
+	m_bakedCache.clear();
 
 	m_device = nullptr;
 }
@@ -127,10 +135,12 @@ ResourceManager::LoadStaticMesh(const std::wstring& fbxPath,
 		}
 	}
 
-	// ----- 실제 FBX 로딩 + GPU 빌드 -----
-	MeshData_PNTT cpu;
-	if (!AssimpImporterEx::LoadFBX_PNTT_AndMaterials(
-		fbxPath, cpu, /*flipUV*/true, /*leftHanded*/true))
+	// ----- 쿡 파일(.mesh) 매핑 또는 FBX 로딩 + GPU 빌드 -----
+	// (매핑/임포트 결과는 버퍼 생성까지만 살아 있으면 됨)
+	MappedFile file;
+	MeshData_PNTT imported;
+	CookedMeshView cpu;
+	if (!CookedMesh::LoadOrCook(fbxPath, /*flipUV*/true, /*leftHanded*/true, file, imported, cpu))
 	{
 		throw std::runtime_error("ResourceManager::LoadStaticMesh - FBX load failed.");
 	}
@@ -186,3 +196,99 @@ ResourceManager::LoadSkinnedModel(const std::wstring& fbxPath,
 
 	throw std::runtime_error("ResourceManager::LoadSkinnedModel - not implemented yet.");
 }
+
+// ---------------------------------------------------------
+// 4) SkeletonAsset
+// ---------------------------------------------------------
+std::shared_ptr<const SkeletonAsset>
+ResourceManager::LoadSkeletonAsset(const std::wstring& fbxPath,
+	const std::wstring& texDir)
+{
+	if (!m_device)
+		throw std::runtime_error("ResourceManager::LoadSkeletonAsset - not initialized.");
+
+	const std::wstring key = MakeKey(fbxPath, texDir);
+
+	// 캐시 확인
+	{
+		auto it = m_skeletonCache.find(key);
+		if (it != m_skeletonCache.end())
+		{
+			if (auto sp = it->second.lock())
+				return sp;
+			m_skeletonCache.erase(it);
+		}
+	}
+
+	auto asset = SkeletonAsset::LoadFromFBX(m_device, fbxPath, texDir);
+
+	m_skeletonCache[key] = asset;
+	return asset;
+}
+
+// ---------------------------------------------------------
+// 5) AnimClipLibrary
+// ---------------------------------------------------------
+std::shared_ptr<const AnimClipLibrary>
+ResourceManager::GetOrBuildAnimClips(const std::wstring& key, const AnimCompressSettings& cs,
+	const std::function<std::shared_ptr<const AnimClipLibrary>()>& build)
+{
+	if (auto sp = FindAnimClips(key, cs))
+		return sp;
+
+	auto lib = build();
+	if (!lib)
+		throw std::runtime_error("ResourceManager::GetOrBuildAnimClips - build failed.");
+
+	m_animCache[AnimClipKey(key, cs)] = lib;
+	return lib;
+}
+
+std::shared_ptr<const AnimClipLibrary>
+ResourceManager::FindAnimClips(const std::wstring& key, const AnimCompressSettings& cs)
+{
+	auto it = m_animCache.find(AnimClipKey(key, cs));
+	if (it == m_animCache.end())
+		return nullptr;
+	if (auto sp = it->second.lock())
+		return sp;
+	m_animCache.erase(it);
+	return nullptr;
+}
+
+// 압축 설정 전체(허용 오차/본별 배율/리샘플)가 키에 들어가야 설정이 바뀐 뒤 옛 클립을 안 돌려준다.
+// .anim 스탬프와 같은 해시를 쓴다.
+std::wstring ResourceManager::AnimClipKey(const std::wstring& key, const AnimCompressSettings& cs)
+{
+	return key + L"|cs" + std::to_wstring(CookedSkeleton::AnimOptions(cs));
+}
+
+const AnimCompressSettings& ResourceManager::GetAnimCompressSettings(const std::wstring& fbxPath) const
+{
+	auto it = m_animSettingsByRig.find(fbxPath);
+	return (it != m_animSettingsByRig.end()) ? it->second : m_animSettings;
+}
+
+// ---------------------------------------------------------
+// 6) BakedClip
+// ---------------------------------------------------------
+std::shared_ptr<const BakedClip>
+ResourceManager::GetOrBakeClip(const std::wstring& key,
+	const std::function<std::shared_ptr<const BakedClip>()>& build)
+{
+	// 캐시 확인
+	{
+		auto it = m_bakedCache.find(key);
+		if (it != m_bakedCache.end())
+		{
+			if (auto sp = it->second.lock())
+				return sp;
+			m_bakedCache.erase(it);
+		}
+	}
+
+	auto baked = build();
+	if (baked)
+		m_bakedCache[key] = baked;
+	return baked;
+}
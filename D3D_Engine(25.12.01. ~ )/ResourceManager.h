@@ -4,6 +4,9 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <functional>
+
+#include "AnimClip.h"  // AnimCompressSettings
 
 struct ID3D11Device;
 struct ID3D11ShaderResourceView;
@@ -11,6 +14,9 @@ struct ID3D11ShaderResourceView;
 class Texture2DResource;
 class StaticMeshResource;
 class SkinnedModelResource;
+class AnimClipLibrary;
+class SkeletonAsset;
+class BakedClip;
 
 class ResourceManager final
 {
@@ -55,6 +61,48 @@ public:
         LoadSkinnedModel(const std::wstring& fbxPath,
             const std::wstring& texDir);
 
+    // ---------------------------------------------------------
+    // 4) SkeletonAsset (계층 + 스키닝 파트 + 머티리얼 + 클립)
+    //    불변 에셋이라 같은 (fbxPath, texDir)의 인스턴스들이 전부 공유.
+    //    인스턴스별 포즈는 SkinnedSkeletal(PoseInstance)이 따로 가진다.
+    // ---------------------------------------------------------
+    std::shared_ptr<const SkeletonAsset>
+        LoadSkeletonAsset(const std::wstring& fbxPath,
+            const std::wstring& texDir);
+
+    // ---------------------------------------------------------
+    // 5) 애니메이션 클립 라이브러리 (CPU 전용, device 필요 없음)
+    //    key   : 리그 식별자 (보통 FBX 경로 + 스켈레톤 종류)
+    //    cs    : 클립을 만든 압축 설정 (GetAnimCompressSettings(fbxPath))
+    //    build : 캐시에 없을 때만 호출. 이미 임포트한 씬에서 만들면 됨.
+    //
+    //    같은 리그를 쓰는 스켈레톤 인스턴스는 클립을 한 벌만 공유.
+    // ---------------------------------------------------------
+    std::shared_ptr<const AnimClipLibrary>
+        GetOrBuildAnimClips(const std::wstring& key, const AnimCompressSettings& cs,
+            const std::function<std::shared_ptr<const AnimClipLibrary>()>& build);
+
+    //    캐시 조회만 (없으면 nullptr). 로더가 .anim 디코드/임포트 전에 먼저 확인할 때.
+    std::shared_ptr<const AnimClipLibrary>
+        FindAnimClips(const std::wstring& key, const AnimCompressSettings& cs);
+
+    //    클립 빌드 설정 (키 제거 허용 오차 / 균일 리샘플). 스켈레톤 로드 전에 설정.
+    //    기본 설정은 전 리그 공통, fbxPath 버전은 그 리그만 덮어쓴다 (균일 리샘플 같은 opt-in은 리그 단위로).
+    //    설정 전체의 해시(CookedSkeleton::AnimOptions)가 캐시 키에 들어가 다른 설정의 클립과 섞이지 않는다.
+    void SetAnimCompressSettings(const AnimCompressSettings& cs) { m_animSettings = cs; }
+    void SetAnimCompressSettings(const std::wstring& fbxPath, const AnimCompressSettings& cs) { m_animSettingsByRig[fbxPath] = cs; }
+    const AnimCompressSettings& GetAnimCompressSettings() const noexcept { return m_animSettings; }
+    const AnimCompressSettings& GetAnimCompressSettings(const std::wstring& fbxPath) const;
+
+    // ---------------------------------------------------------
+    // 6) 베이크된 클립 (군중 재생용 팔레트 테이블, CPU 전용)
+    //    key   : 에셋 경로 + 클립 압축 설정 해시 + 클립 인덱스 + 베이크 설정
+    //    build : 캐시에 없을 때만 호출. 실패(상한 초과 등)하면 nullptr 반환, 캐시 안 함.
+    // ---------------------------------------------------------
+    std::shared_ptr<const BakedClip>
+        GetOrBakeClip(const std::wstring& key,
+            const std::function<std::shared_ptr<const BakedClip>()>& build);
+
 private:
     ResourceManager() = default;
     ~ResourceManager() = default;
@@ -65,14 +113,24 @@ private:
     // (fbxPath, texDir) 같이 두 개를 key로 쓰고 싶을 때
     static std::wstring MakeKey(const std::wstring& a,
         const std::wstring& b);
+    static std::wstring AnimClipKey(const std::wstring& key, const AnimCompressSettings& cs);
 
     ID3D11Device* m_device = nullptr; // 우리가 AddRef 안 함. TutorialApp이 소유.
 
     using TexCache = std::unordered_map<std::wstring, std::weak_ptr<Texture2DResource>>;
     using StaticMeshCache = std::unordered_map<std::wstring, std::weak_ptr<StaticMeshResource>>;
     using SkinnedMeshCache = std::unordered_map<std::wstring, std::weak_ptr<SkinnedModelResource>>;
+    using SkeletonCache = std::unordered_map<std::wstring, std::weak_ptr<const SkeletonAsset>>;
+    using AnimClipCache = std::unordered_map<std::wstring, std::weak_ptr<const AnimClipLibrary>>;
+    using BakedClipCache = std::unordered_map<std::wstring, std::weak_ptr<const BakedClip>>;
 
     TexCache        m_texCache;
     StaticMeshCache m_staticCache;
     SkinnedMeshCache m_skinnedCache;
+    SkeletonCache   m_skeletonCache;
+    AnimClipCache   m_animCache;
+    BakedClipCache  m_bakedCache;
+
+    AnimCompressSettings m_animSettings;
+    std::unordered_map<std::wstring, AnimCompressSettings> m_animSettingsByRig; // fbxPath -> 덮어쓴 설정
 };
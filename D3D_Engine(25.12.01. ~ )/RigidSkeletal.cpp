@@ -3,13 +3,12 @@
 #include "../D3D_Core/Helper.h"
 
 #include "RigidSkeletal.h"
-#include "AssimpImporterEX.h"
+#include "ResourceManager.h"
 #include "RenderSharedCB.h"
-#include <assimp/Importer.hpp>
+#include "PoseMath.h"
+#include "CookedSkeleton.h"
 
-
-#include <assimp/scene.h>
-#include <assimp/postprocess.h>
+#include <chrono>
 
 using namespace DirectX;
 using namespace DirectX::SimpleMath;
@@ -21,103 +20,6 @@ static inline double fmod_pos(double x, double period) {
 	return (r < 0.0) ? r + period : r;
 }
 
-// ===== ai -> DX 변환 =====
-static Matrix ToM(const aiMatrix4x4& A)
-{
-	// Assimp의 aiMatrix4x4는 행우선. SimpleMath::Matrix도 행우선.
-	return Matrix(
-		A.a1, A.b1, A.c1, A.d1,
-		A.a2, A.b2, A.c2, A.d2,
-		A.a3, A.b3, A.c3, A.d3,
-		A.a4, A.b4, A.c4, A.d4
-	);
-}
-static Quaternion ToQ(const aiQuaternion& q)
-{
-	return Quaternion(q.x, q.y, q.z, q.w);
-}
-static Vector3 ToV3(const aiVector3D& v)
-{
-	return { v.x, v.y, v.z };
-}
-
-// ===== 키프레임 upper bound =====
-int RigidSkeletal::UpperBoundT(double t, const std::vector<RS_KeyT>& v)
-{
-	int n = (int)v.size();
-	int i = 0; while (i < n && v[i].t <= t) ++i; return i;
-}
-int RigidSkeletal::UpperBoundR(double t, const std::vector<RS_KeyR>& v)
-{
-	int n = (int)v.size();
-	int i = 0; while (i < n && v[i].t <= t) ++i; return i;
-}
-int RigidSkeletal::UpperBoundS(double t, const std::vector<RS_KeyS>& v)
-{
-	int n = (int)v.size();
-	int i = 0; while (i < n && v[i].t <= t) ++i; return i;
-}
-
-// ===== 로컬 행렬 샘플링 =====
-Matrix RigidSkeletal::SampleLocalOf(int nodeIdx, double tTick) const
-{
-	const RS_Node& nd = mNodes[nodeIdx];
-
-	// 채널 찾기
-	Matrix S = Matrix::Identity, R = Matrix::Identity, T = Matrix::Identity;
-
-	auto it = mClip.map.find(nd.name);
-	if (it == mClip.map.end()) {
-		// 애니 없으면 바인드 로컬 유지
-		return nd.bindLocal;
-	}
-	const RS_Channel& ch = mClip.channels[it->second];
-
-	// T
-	if (!ch.T.empty()) {
-		int ub = UpperBoundT(tTick, ch.T);
-		if (ub <= 0) T = Matrix::CreateTranslation(ch.T.front().v);
-		else if (ub >= (int)ch.T.size()) T = Matrix::CreateTranslation(ch.T.back().v);
-		else {
-			const auto& a = ch.T[ub - 1]; const auto& b = ch.T[ub];
-			double len = b.t - a.t; double u = (len > 0.0) ? (tTick - a.t) / len : 0.0;
-			Vector3 v = a.v + (b.v - a.v) * float(u);
-			T = Matrix::CreateTranslation(v);
-		}
-	}
-	else T = Matrix::Identity;
-
-	// R
-	if (!ch.R.empty()) {
-		int ub = UpperBoundR(tTick, ch.R);
-		if (ub <= 0) R = Matrix::CreateFromQuaternion(ch.R.front().q);
-		else if (ub >= (int)ch.R.size()) R = Matrix::CreateFromQuaternion(ch.R.back().q);
-		else {
-			const auto& a = ch.R[ub - 1]; const auto& b = ch.R[ub];
-			double len = b.t - a.t; double u = (len > 0.0) ? (tTick - a.t) / len : 0.0;
-			Quaternion q = Quaternion::Slerp(a.q, b.q, float(u));
-			R = Matrix::CreateFromQuaternion(q);
-		}
-	}
-	else R = Matrix::Identity;
-
-	// S
-	if (!ch.S.empty()) {
-		int ub = UpperBoundS(tTick, ch.S);
-		if (ub <= 0) S = Matrix::CreateScale(ch.S.front().v);
-		else if (ub >= (int)ch.S.size()) S = Matrix::CreateScale(ch.S.back().v);
-		else {
-			const auto& a = ch.S[ub - 1]; const auto& b = ch.S[ub];
-			double len = b.t - a.t; double u = (len > 0.0) ? (tTick - a.t) / len : 0.0;
-			Vector3 v = a.v + (b.v - a.v) * float(u);
-			S = Matrix::CreateScale(v);
-		}
-	}
-	else S = Matrix::Identity;
-
-	return S * R * T;
-}
-
 // ===== 로딩 =====
 std::unique_ptr<RigidSkeletal> RigidSkeletal::LoadFromFBX(
 	ID3D11Device* dev,
@@ -126,129 +28,43 @@ std::unique_ptr<RigidSkeletal> RigidSkeletal::LoadFromFBX(
 {
 	auto up = std::unique_ptr<RigidSkeletal>(new RigidSkeletal);
 
-	Assimp::Importer imp;
-	unsigned flags =
-		aiProcess_Triangulate |
-		aiProcess_JoinIdenticalVertices |
-		aiProcess_ImproveCacheLocality |
-		aiProcess_SortByPType |
-		aiProcess_CalcTangentSpace |
-		aiProcess_GenNormals |
-		aiProcess_ConvertToLeftHanded |
-		aiProcess_FlipUVs;
-
-	const aiScene* sc = imp.ReadFile(std::string(fbxPath.begin(), fbxPath.end()), flags);
-	if (!sc || !sc->mRootNode) throw std::runtime_error("Assimp load failed");
-
-	// --- 1) 노드 트리 구축 ---
-	std::vector<RS_Node> nodes;
+	// --- 1) CPU 데이터: .rigid.skel/.anim이 최신이면 매핑해서 읽고, 아니면 Assimp 임포트 후 쿡 ---
+	const auto t0 = std::chrono::steady_clock::now();
+	SkeletonCPU cpu;
+	bool cooked = false;
+	ResourceManager& rm = ResourceManager::Instance();
+	const AnimCompressSettings& cs = rm.GetAnimCompressSettings(fbxPath);
+	const std::wstring clipKey = fbxPath + L"|RigidSkeletal";
+	auto clips = rm.FindAnimClips(clipKey, cs); // 이미 있으면 .anim은 디코드하지 않는다
+	if (!CookedSkeleton::LoadOrCook(fbxPath, /*skinned*/false, cs, cpu, &cooked, /*loadClips*/!clips))
+		throw std::runtime_error("Assimp load failed");
+	const double cpuMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+	// --- 2) 노드 트리 (DFS 순서 그대로) ---
+	std::vector<RS_Node> nodes(cpu.nodes.size());
 	std::unordered_map<std::string, int> nameToIdx;
+	for (size_t i = 0; i < cpu.nodes.size(); ++i) {
+		RS_Node& nd = nodes[i];
+		nd.name = std::move(cpu.nodes[i].name);
+		nd.parent = cpu.nodes[i].parent;
+		nd.bindLocal = Matrix(cpu.nodes[i].bindLocal);
+		if (nd.parent >= 0) nodes[nd.parent].children.push_back((int)i);
+		nameToIdx[nd.name] = (int)i;
+	}
 
-	std::function<int(const aiNode*, int)> buildNode = [&](const aiNode* an, int parent) -> int {
-		RS_Node nd;
-		nd.name = an->mName.C_Str();
-		nd.parent = parent;
-		nd.bindLocal = ToM(an->mTransformation);
-		int my = (int)nodes.size();
-		nodes.push_back(nd);
-		nameToIdx[nd.name] = my;
-
-		// children
-		for (unsigned c = 0; c < an->mNumChildren; ++c) {
-			int cid = buildNode(an->mChildren[c], my);
-			nodes[my].children.push_back(cid);
-		}
-		return my;
-		};
-	int root = buildNode(sc->mRootNode, -1);
-
-	// --- 2) 파트(StaticMesh) 구성: 노드에 붙은 aiMesh를 각자 하나의 파트로 만든다 ---
+	// --- 3) 파트(StaticMesh): 노드에 붙은 aiMesh 하나 = 파트 하나 ---
 	std::vector<RS_Part> parts;
-
-	std::vector<MaterialCPU> sceneMaterials;
-	AssimpImporterEx::ExtractMaterials(sc, sceneMaterials);
-
-	auto buildPartFromAiMesh = [&](unsigned meshIndex, int ownerNode) {
-		const aiMesh* am = sc->mMeshes[meshIndex];
-
-		MeshData_PNTT cpu; // 네 새 구조: vertices / indices / submeshes / materials
-		cpu.vertices.resize(am->mNumVertices);
-
-		for (unsigned v = 0; v < am->mNumVertices; ++v) {
-			VertexCPU_PNTT vv{};
-
-			// position
-			vv.px = am->mVertices[v].x;
-			vv.py = am->mVertices[v].y;
-			vv.pz = am->mVertices[v].z;
-
-			// normal
-			if (am->mNormals) {
-				vv.nx = am->mNormals[v].x;
-				vv.ny = am->mNormals[v].y;
-				vv.nz = am->mNormals[v].z;
-			}
-			else {
-				vv.nx = 0; vv.ny = 1; vv.nz = 0;
-			}
-
-			// uv (채널 0)
-			if (am->mTextureCoords[0]) {
-				vv.u = am->mTextureCoords[0][v].x;
-				vv.v = am->mTextureCoords[0][v].y;
-			}
-			else {
-				vv.u = vv.v = 0.0f;
-			}
-
-			if (am->mTangents && am->mBitangents) {
-				const aiVector3D& t = am->mTangents[v];
-				const aiVector3D& b = am->mBitangents[v];
-
-				
-
-				Vector3 T(am->mTangents[v].x, am->mTangents[v].y, am->mTangents[v].z);
-				Vector3 B(am->mBitangents[v].x, am->mBitangents[v].y, am->mBitangents[v].z);
-				Vector3 N(vv.nx, vv.ny, vv.nz);
-
-				Vector3 C(N.y * T.z - N.z * T.y,
-					N.z * T.x - N.x * T.z,
-					N.x * T.y - N.y * T.x);
-
-				float sign = ((C.x * B.x + C.y * B.y + C.z * B.z) < 0.0f) ? -1.0f : 1.0f;
-
-				vv.tx = T.x; vv.ty = T.y; vv.tz = T.z; vv.tw = sign;
-			}
-			else {
-				vv.tx = 1.0f; vv.ty = 0.0f; vv.tz = 0.0f; vv.tw = 1.0f;
-			}
-
-			cpu.vertices[v] = vv;
-		}
-
-		// indices
-		cpu.indices.reserve(am->mNumFaces * 3);
-		for (unsigned f = 0; f < am->mNumFaces; ++f) {
-			const aiFace& face = am->mFaces[f];
-			for (unsigned k = 0; k < face.mNumIndices; ++k)
-				cpu.indices.push_back(static_cast<uint32_t>(face.mIndices[k]));
-		}
-
-		// submesh (aiMesh 하나 = 하나의 서브메시)
-		cpu.submeshes.clear();
-		SubMeshCPU sm{};
-		sm.baseVertex = 0;
-		sm.indexStart = 0;
-		sm.indexCount = static_cast<uint32_t>(cpu.indices.size());
-		sm.materialIndex = am->mMaterialIndex;
-		cpu.submeshes.push_back(sm);
-
-		// materials (장면 전체 리스트 복사)
-		cpu.materials = sceneMaterials;
+	parts.reserve(cpu.parts.size());
+	for (const SkeletonCPU::Part& cp : cpu.parts) {
+		// 정점/인덱스는 그대로 버퍼 초기 데이터로 (서브메시 하나)
+		const SubMeshCPU sm{ 0, 0, (uint32_t)cp.indices.size(), cp.materialIndex };
+		CookedMeshView view;
+		CookedMesh::ViewOf(cp.rigidVertices.data(), (uint32_t)cp.rigidVertices.size(),
+			cp.indices.data(), (uint32_t)cp.indices.size(), &sm, 1, view);
 
 		// GPU 빌드
 		RS_Part part;
-		if (!part.mesh.Build(dev, cpu))
+		if (!part.mesh.Build(dev, view))
 			throw std::runtime_error("part mesh build failed");
 
 		// 네 렌더러가 MaterialGPU::Bind를 직접 쓰는 구조라면 유지
@@ -256,80 +72,74 @@ std::unique_ptr<RigidSkeletal> RigidSkeletal::LoadFromFBX(
 		for (size_t i = 0; i < cpu.materials.size(); ++i)
 			part.materials[i].Build(dev, cpu.materials[i], texDir);
 
-		part.ownerNode = ownerNode;
-		nodes[ownerNode].partIndices.push_back((int)parts.size());
+		part.ownerNode = cp.ownerNode;
+		nodes[cp.ownerNode].partIndices.push_back((int)parts.size());
 		parts.push_back(std::move(part));
-		};
-
-	// 각 노드에 할당된 aiMesh들 생성
-	std::function<void(const aiNode*)> collectMeshes = [&](const aiNode* an) {
-		int owner = nameToIdx[an->mName.C_Str()];
-		for (unsigned m = 0; m < an->mNumMeshes; ++m) {
-			buildPartFromAiMesh(an->mMeshes[m], owner);
-		}
-		for (unsigned c = 0; c < an->mNumChildren; ++c)
-			collectMeshes(an->mChildren[c]);
-		};
-	collectMeshes(sc->mRootNode);
-
-	// --- 3) 애니메이션(첫 개) 파싱 ---
-	RS_Clip clip;
-	if (sc->mNumAnimations > 0) {
-		const aiAnimation* a = sc->mAnimations[0];
-		clip.name = a->mName.C_Str(); // 예: "Walk"일 수도 있고 공백일 수도
-		clip.duration = a->mDuration;
-		clip.ticksPerSec = (a->mTicksPerSecond > 0.0) ? a->mTicksPerSecond : 25.0;
-
-		clip.channels.reserve(a->mNumChannels);
-		for (unsigned i = 0; i < a->mNumChannels; ++i) {
-			const aiNodeAnim* na = a->mChannels[i];
-			RS_Channel ch;
-			ch.target = na->mNodeName.C_Str();
-
-			for (unsigned k = 0; k < na->mNumPositionKeys; ++k)
-				ch.T.push_back({ na->mPositionKeys[k].mTime, ToV3(na->mPositionKeys[k].mValue) });
-			for (unsigned k = 0; k < na->mNumRotationKeys; ++k)
-				ch.R.push_back({ na->mRotationKeys[k].mTime, ToQ(na->mRotationKeys[k].mValue) });
-			for (unsigned k = 0; k < na->mNumScalingKeys; ++k)
-				ch.S.push_back({ na->mScalingKeys[k].mTime, ToV3(na->mScalingKeys[k].mValue) });
-
-			clip.map[ch.target] = (int)clip.channels.size();
-			clip.channels.push_back(std::move(ch));
-		}
 	}
 
+	// --- 4) 애니메이션: 모든 클립을 리그 단위로 한 번만 로드/공유 ---
+	if (!clips) clips = rm.GetOrBuildAnimClips(clipKey, cs, [&] { return cpu.clips; });
+
+	LOG_MESSAGEA("Rigid skeleton (%s): %.2f ms, %zu nodes, %zu parts",
+		cooked ? "cooked" : "assimp", cpuMs, nodes.size(), parts.size());
+
+	// 부모 인덱스 평탄화 (DFS로 쌓여서 부모가 항상 앞)
+	up->mParents.resize(nodes.size());
+	for (size_t i = 0; i < nodes.size(); ++i) up->mParents[i] = nodes[i].parent;
+	up->mPoseLocal.assign(nodes.size(), PoseMath::PoseTRS{});
+	up->mBindPose.resize(nodes.size());
+	for (size_t i = 0; i < nodes.size(); ++i) up->mBindPose[i] = PoseMath::DecomposeTRS(nodes[i].bindLocal);
+	// 정적 서브트리(파트가 많이 매달린 헬퍼/메시 소유 노드)는 글로벌을 로드 때 한 번만
+	up->mPoseGlobal.resize(nodes.size());
+	PoseMath::LocalToGlobal(up->mParents.data(), nodes.size(), up->mBindPose.data(), up->mPoseGlobal.data());
+	const std::vector<uint8_t> animated = clips->AnimatedMask(nodes.size());
+	up->mDynamicNodes = PoseMath::DynamicNodes(up->mParents.data(), nodes.size(), animated.data());
+
 	up->mNodes = std::move(nodes);
 	up->mParts = std::move(parts);
 	up->mNameToNode = std::move(nameToIdx);
-	up->mRoot = root;
-	up->mClip = std::move(clip);
+	up->mRoot = 0;
+	up->mClips = std::move(clips);
+	up->SetClip(0);
 
 	return up;
 }
 
+// ===== 클립 전환 =====
+bool RigidSkeletal::SetClip(size_t index)
+{
+	if (!mClips || index >= mClips->Count()) return false;
+	mClip = mClips->Get(index);
+	mCursors.assign(mClip->channels.size(), AnimCursor{}); // 커서는 클립 채널 기준
+	return true;
+}
+
+bool RigidSkeletal::SetClip(const std::string& name)
+{
+	const int i = mClips ? mClips->IndexOf(name) : -1;
+	return (i >= 0) && SetClip((size_t)i);
+}
+
 // ===== 포즈 평가 =====
 void RigidSkeletal::EvaluatePose(double tSec, bool loop)
 {
-	if (mClip.duration <= 0.0) {
-		for (auto& n : mNodes) n.poseLocal = n.bindLocal;
+	if (!mClip || mClip->duration <= 0.0) {
+		mPoseLocal = mBindPose;
 	}
 	else {
-		const double tps = (mClip.ticksPerSec > 0.0) ? mClip.ticksPerSec : 25.0;
+		const double tps = (mClip->ticksPerSec > 0.0) ? mClip->ticksPerSec : 25.0;
 		const double T = tSec * tps; // seconds → ticks
-		const double u = loop ? fmod_pos(T, mClip.duration)
-			: std::clamp(T, 0.0, mClip.duration);
+		const double u = loop ? fmod_pos(T, mClip->duration)
+			: std::clamp(T, 0.0, mClip->duration);
 
-		for (int i = 0; i < (int)mNodes.size(); ++i)
-			mNodes[i].poseLocal = SampleLocalOf(i, u);
+		// 채널 있는 노드에서 키가 없는 성분은 Identity (T 포함)
+		mClip->SampleLocalPose((float)u, mCursors.data(), mBindPose.data(), /*bindTWhenMissing*/false,
+			mPoseLocal.data());
 	}
 
-	// 글로벌 갱신(네 기존 코드 유지)
-	std::function<void(int, const Matrix&)> updateGlobal = [&](int idx, const Matrix& parent) {
-		mNodes[idx].poseGlobal = mNodes[idx].poseLocal * parent;
-		for (int c : mNodes[idx].children)
-			updateGlobal(c, mNodes[idx].poseGlobal);
-		};
-	updateGlobal(mRoot, Matrix::Identity);
+	// 글로벌 갱신: 동적 노드만 부모 인덱스 따라 선형 1패스 (정적 노드는 로드 때 계산한 값 유지)
+	PoseMath::LocalToGlobalSubset(mParents.data(), mDynamicNodes.data(), mDynamicNodes.size(),
+		mPoseLocal.data(), mPoseGlobal.data());
 }
 
 // 기존 함수는 루프=true로 위임(호환)
@@ -388,7 +198,7 @@ void RigidSkeletal::DrawOpaqueOnly(
 			const auto& mat = part.materials[r.materialIndex];
 			if (mat.hasOpacity) continue;
 
-			const Matrix world = mNodes[part.ownerNode].poseGlobal * worldModel;
+			const Matrix world = mPoseGlobal[part.ownerNode] * worldModel;
 
 			ConstantBuffer cb{};
 			FillCB(cb, world, /*view*/view, /*proj*/proj, vLightDir, vLightColor);
@@ -425,7 +235,7 @@ void RigidSkeletal::DrawAlphaCutOnly(
 			const auto& mat = part.materials[r.materialIndex];
 			if (!mat.hasOpacity) continue; // 컷아웃 패스: opacity 있는 애만
 
-			const Matrix world = mNodes[part.ownerNode].poseGlobal * worldModel;
+			const Matrix world = mPoseGlobal[part.ownerNode] * worldModel;
 
 			ConstantBuffer cb{};
 			FillCB(cb, world, view, proj, vLightDir, vLightColor);
@@ -463,7 +273,7 @@ void RigidSkeletal::DrawTransparentOnly(
 			const auto& mat = part.materials[r.materialIndex];
 			if (!mat.hasOpacity) continue; // 투명 패스: opacity 있는 애만
 
-			const Matrix world = mNodes[part.ownerNode].poseGlobal * worldModel;
+			const Matrix world = mPoseGlobal[part.ownerNode] * worldModel;
 
 			ConstantBuffer cb{};
 			FillCB(cb, world, view, proj, vLightDir, vLightColor);
@@ -498,7 +308,7 @@ void RigidSkeletal::DrawDepthOnly(
 	for (const auto& part : mParts)
 	{
 		const auto& ranges = part.mesh.Ranges();
-		const Matrix world = mNodes[part.ownerNode].poseGlobal * worldModel;
+		const Matrix world = mPoseGlobal[part.ownerNode] * worldModel;
 
 		ConstantBuffer cb{};
 		cb.mWorld = XMMatrixTranspose(world);
@@ -8,46 +8,25 @@
 
 #include "StaticMesh.h"
 #include "Material.h"
+#include "AnimClip.h"
+#include "PoseMath.h"
 
 using namespace DirectX::SimpleMath;
 
+// 노드 이름/토폴로지 테이블 (콜드: 로드와 디버그 UI에서만). 포즈 패스는 안 건드린다.
+// 매 프레임 쓰는 값은 RigidSkeletal의 연속 배열 쪽 (mParents / mBindPose / mPoseLocal / mPoseGlobal).
 struct RS_Node
 {
     std::string name;
     int parent = -1;
     std::vector<int> children;
 
-    Matrix bindLocal = Matrix::Identity;     // FBX 노드의 로컬 바인드
-    Matrix poseLocal = Matrix::Identity;     // 애니메이션으로 계산된 로컬 포즈
-    Matrix poseGlobal = Matrix::Identity;    // 부모 누적된 글로벌 포즈
+    Matrix bindLocal = Matrix::Identity;     // FBX 노드의 로컬 바인드 (TRS 분해본은 mBindPose)
 
     // 이 노드에 붙은 '부분 메시' 인덱스(여러 개일 수 있음, 보통 0~1개)
     std::vector<int> partIndices;
 };
 
-struct RS_KeyT { double t; Vector3 v; };
-struct RS_KeyR { double t; Quaternion q; };
-struct RS_KeyS { double t; Vector3 v; };
-
-struct RS_Channel
-{
-    std::string target;          // 노드 이름
-    std::vector<RS_KeyT> T;
-    std::vector<RS_KeyR> R;
-    std::vector<RS_KeyS> S;
-};
-
-struct RS_Clip
-{
-    std::string name;
-    double duration = 0.0;       // ticks
-    double ticksPerSec = 25.0;   // 기본 25
-    std::vector<RS_Channel> channels;
-
-    // targetName -> index
-    std::unordered_map<std::string, int> map;
-};
-
 struct RS_Part
 {
     // 각 파트는 독립 StaticMesh (간단하게 구현; BoxHuman는 파트 수 적음)
@@ -65,7 +44,7 @@ public:
         const std::wstring& fbxPath,
         const std::wstring& texDir);
 
-    // 시간 업데이트(tSec = 초). 첫 애니메이션(보통 Walk)을 사용
+    // 시간 업데이트(tSec = 초). 현재 선택된 클립 사용 (로드 직후엔 첫 클립)
     void EvaluatePose(double tSec);
     void EvaluatePose(double tSec, bool loop);      // 
 
@@ -123,28 +102,37 @@ public:
 
 
 public:
+    // --- 클립 전환 (라이브러리 안의 포인터만 교체, 재임포트 없음) ---
+    bool SetClip(size_t index);
+    bool SetClip(const std::string& name);
+
     // --- IMGUI/타이밍용 간단 Getter ---
-    double GetClipDurationTicks() const noexcept { return mClip.duration; }
-    double GetTicksPerSecond()   const noexcept { return (mClip.ticksPerSec > 0.0) ? mClip.ticksPerSec : 25.0; }
+    double GetClipDurationTicks() const noexcept { return mClip ? mClip->duration : 0.0; }
+    double GetTicksPerSecond()   const noexcept { return (mClip && mClip->ticksPerSec > 0.0) ? mClip->ticksPerSec : 25.0; }
     double GetClipDurationSec()  const noexcept { return GetClipDurationTicks() / GetTicksPerSecond(); }
-    const std::string& GetClipName() const noexcept { return mClip.name; }
+    const AnimClip* GetClip() const noexcept { return mClip.get(); }
+    const AnimClipLibrary* GetClipLibrary() const noexcept { return mClips.get(); }
+    const std::vector<Matrix>& GetPoseGlobal() const noexcept { return mPoseGlobal; }
+    const std::vector<PoseMath::PoseTRS>& GetBindPose() const noexcept { return mBindPose; }
+    size_t GetNodeCount() const noexcept { return mNodes.size(); }
+    size_t GetDynamicNodeCount() const noexcept { return mDynamicNodes.size(); }
 
 
 private:
     RigidSkeletal() = default;
 
-    // 내부 유틸(보간)
-    static int UpperBoundT(double t, const std::vector<RS_KeyT>& v);
-    static int UpperBoundR(double t, const std::vector<RS_KeyR>& v);
-    static int UpperBoundS(double t, const std::vector<RS_KeyS>& v);
-
-    Matrix SampleLocalOf(int nodeIdx, double tTick) const;
-
 private:
-    std::vector<RS_Node> mNodes;
+    std::vector<RS_Node> mNodes;       // 위상 순서 (부모 인덱스 < 자식 인덱스)
+    std::vector<int>     mParents;     // 노드별 부모 인덱스 (평탄화, 루트 -1)
+    std::vector<PoseMath::PoseTRS> mPoseLocal; // 애니메이션으로 계산된 로컬 포즈 (TRS)
+    std::vector<PoseMath::PoseTRS> mBindPose;  // 노드별 bindTRS 연속 배열 (배치 샘플링 입력)
+    std::vector<Matrix>  mPoseGlobal;  // 부모 누적된 글로벌 포즈 (정적 노드는 로드 때 한 번)
+    std::vector<int>     mDynamicNodes; // 어떤 클립이든 채널이 있는 노드 + 그 자손 (위상 순서)
     std::vector<RS_Part> mParts;
 
-    RS_Clip mClip;     // 첫 번째 클립 사용(예: Walk)
+    std::shared_ptr<const AnimClipLibrary> mClips; // FBX의 모든 클립 (같은 리그끼리 공유)
+    std::shared_ptr<const AnimClip> mClip;         // 현재 클립 (null = 바인드 포즈)
+    std::vector<AnimCursor> mCursors; // 채널 인덱스 -> 키 커서
     int mRoot = 0;
 
     // 캐시: 이름->노드
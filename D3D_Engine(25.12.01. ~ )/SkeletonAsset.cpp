@@ -0,0 +1,136 @@
+﻿// SkeletonAsset.cpp
+#include "../D3D_Core/pch.h"
+#include "../D3D_Core/Helper.h"
+
+#include "SkeletonAsset.h"
+#include "ResourceManager.h"
+#include "PoseMath.h"
+#include "CookedSkeleton.h"
+
+#include <chrono>
+
+// ===== 로드 =====
+std::shared_ptr<const SkeletonAsset> SkeletonAsset::LoadFromFBX(
+	ID3D11Device* dev,
+	const std::wstring& fbxPath,
+	const std::wstring& texDir)
+{
+	auto up = std::make_shared<SkeletonAsset>();
+	ResourceManager& rm = ResourceManager::Instance();
+
+	// --- 1) CPU 데이터: .skel/.anim이 최신이면 매핑해서 읽고, 아니면 Assimp 임포트 후 쿡 ---
+	const auto t0 = std::chrono::steady_clock::now();
+	SkeletonCPU cpu;
+	bool cooked = false;
+	const AnimCompressSettings& cs = rm.GetAnimCompressSettings(fbxPath);
+	const std::wstring clipKey = fbxPath + L"|SkinnedSkeletal";
+	auto clips = rm.FindAnimClips(clipKey, cs); // 이미 있으면 .anim은 디코드하지 않는다
+	if (!CookedSkeleton::LoadOrCook(fbxPath, /*skinned*/true, cs, cpu, &cooked, /*loadClips*/!clips))
+		throw std::runtime_error("Skeleton load failed");
+	const double cpuMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+	up->mGlobalInv = Matrix(cpu.globalInv);
+
+	// --- 2) 노드 테이블 (DFS 순서 그대로) ---
+	std::vector<SK_Node> nodes(cpu.nodes.size());
+	std::unordered_map<std::string, int> nameToIdx;
+	for (size_t i = 0; i < cpu.nodes.size(); ++i) {
+		SK_Node& nd = nodes[i];
+		nd.name = std::move(cpu.nodes[i].name);
+		nd.parent = cpu.nodes[i].parent;
+		nd.bindLocal = Matrix(cpu.nodes[i].bindLocal);
+		if (nd.parent >= 0) nodes[nd.parent].children.push_back((int)i);
+		nameToIdx[nd.name] = (int)i;
+	}
+
+	// --- 3) 파트 GPU 빌드 + 재질 (디바이스 호출은 파트 순서대로) ---
+	std::vector<SK_Part> parts;
+	parts.reserve(cpu.parts.size());
+	for (SkeletonCPU::Part& cp : cpu.parts) {
+		std::vector<SubMeshCPU> submeshes;
+		submeshes.push_back({ 0,0,(uint32_t)cp.indices.size(), cp.materialIndex });
+
+		// build gpu mesh
+		SK_Part part;
+		if (!part.mesh.Build(dev, cp.skinnedVertices, cp.indices, submeshes))
+			throw std::runtime_error("SkinnedMesh build failed");
+
+		// materials
+		part.materials.clear(); part.materials.resize(cpu.materials.size());
+		for (size_t i = 0; i < cpu.materials.size(); ++i)
+			part.materials[i].Build(dev, cpu.materials[i], texDir);
+
+		part.ownerNode = cp.ownerNode;
+		part.boneBoxes = std::move(cp.boneBoxes);
+		nodes[cp.ownerNode].partIndices.push_back((int)parts.size());
+		parts.push_back(std::move(part));
+	}
+
+	// --- 4) 본: 이름/노드 (콜드) + 노드/inverse bind 연속 배열 (핫) ---
+	std::vector<SK_Bone> bones(cpu.bones.size());
+	up->mBoneNodes.resize(cpu.bones.size());
+	up->mBoneOffsets.resize(cpu.bones.size());
+	for (size_t i = 0; i < cpu.bones.size(); ++i) {
+		bones[i].name = std::move(cpu.bones[i].name);
+		bones[i].node = cpu.bones[i].node;
+		up->mBoneNodes[i] = cpu.bones[i].node;
+		up->mBoneOffsets[i] = Matrix(cpu.bones[i].offset);
+	}
+
+	// --- 5) 애니메이션: 모든 클립을 리그 단위로 한 번만 로드/공유 ---
+	if (!clips) clips = rm.GetOrBuildAnimClips(clipKey, cs, [&] { return cpu.clips; });
+
+	if (cooked)
+		LOG_MESSAGEA("Skeleton (cooked): %.2f ms, %zu nodes, %zu bones, %zu parts", cpuMs, nodes.size(), bones.size(), parts.size());
+	else
+		LOG_MESSAGEA("Skeleton (assimp): %.2f ms (parts %.2f ms), %zu nodes, %zu bones, %zu parts",
+			cpuMs, cpu.partBuildMs, nodes.size(), bones.size(), parts.size());
+
+	// 부모 인덱스 평탄화 (DFS로 쌓여서 부모가 항상 앞)
+	up->mParents.resize(nodes.size());
+	for (size_t i = 0; i < nodes.size(); ++i) up->mParents[i] = nodes[i].parent;
+	up->mBindPose.resize(nodes.size());
+	for (size_t i = 0; i < nodes.size(); ++i) up->mBindPose[i] = PoseMath::DecomposeTRS(nodes[i].bindLocal);
+
+	// 정적 서브트리: 글로벌은 로드 때 한 번, 매 프레임은 동적 노드만
+	up->mBindGlobal.resize(nodes.size());
+	PoseMath::LocalToGlobal(up->mParents.data(), nodes.size(), up->mBindPose.data(), up->mBindGlobal.data());
+	const std::vector<uint8_t> animated = clips->AnimatedMask(nodes.size());
+	up->mDynamicNodes = PoseMath::DynamicNodes(up->mParents.data(), nodes.size(), animated.data());
+
+	up->mNodes = std::move(nodes);
+	up->mParts = std::move(parts);
+	up->mBones = std::move(bones);
+	up->mNameToNode = std::move(nameToIdx);
+	up->mClips = std::move(clips);
+	up->mRoot = 0;
+	up->mSourcePath = fbxPath;
+	up->mClipSettingsHash = CookedSkeleton::AnimOptions(cs);
+
+	return up;
+}
+
+int SkeletonAsset::FindNode(const std::string& name) const
+{
+	auto it = mNameToNode.find(name);
+	return (it != mNameToNode.end()) ? it->second : -1;
+}
+
+// ===== PoseInstance =====
+void PoseInstance::Init(const SkeletonAsset& asset)
+{
+	local = asset.BindPose();
+	global = asset.BindGlobal(); // 정적 노드는 이후 갱신 안 함
+
+	palette.assign(asset.Bones().size(), PoseMath::BoneIdentity());
+	cursors.assign(clip ? clip->channels.size() : 0, AnimCursor{});
+}
+
+size_t PoseInstance::MemoryBytes() const
+{
+	return sizeof(PoseInstance)
+		+ local.capacity() * sizeof(PoseMath::PoseTRS)
+		+ global.capacity() * sizeof(Matrix)
+		+ palette.capacity() * sizeof(PoseMath::BoneMatrix)
+		+ cursors.capacity() * sizeof(AnimCursor);
+}
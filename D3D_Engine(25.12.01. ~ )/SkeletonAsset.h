@@ -0,0 +1,113 @@
+﻿// SkeletonAsset.h
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <directxtk/SimpleMath.h>
+#include <DirectXCollision.h>
+#include <d3d11.h>
+
+#include "SkinnedMesh.h"
+#include "Material.h"
+#include "AnimClip.h"
+#include "PoseMath.h"
+#include "SkeletonImport.h" // SK_BoneBox
+
+using namespace DirectX::SimpleMath;
+
+//================================================================================================
+// 스키닝 캐릭터 = 공유 에셋(SkeletonAsset) + 인스턴스 상태(PoseInstance)
+//  - SkeletonAsset : 계층/바인드 포즈/inverse bind/GPU 파트/머티리얼/클립. 로드 후 불변.
+//                    ResourceManager::LoadSkeletonAsset으로 FBX당 한 번만 만들어 공유.
+//  - PoseInstance  : 현재 클립/시간/커서 + 노드별 로컬/글로벌 행렬 + 본 팔레트.
+//  => 메모리/로드 시간은 고유 에셋 수에 비례하고, 인스턴스는 행렬 버퍼 몇 개만 든다.
+//================================================================================================
+
+// 노드/본 이름·토폴로지 테이블 (콜드: 로드와 디버그 UI에서만).
+// 포즈 패스가 읽는 값은 SkeletonAsset의 연속 배열 (Parents / BindPose / BindGlobal / BoneNodes / BoneOffsets).
+struct SK_Node {
+    std::string name;
+    int parent = -1;
+    std::vector<int> children;
+    Matrix bindLocal = Matrix::Identity; // TRS 분해본은 BindPose()
+    std::vector<int> partIndices;
+};
+
+struct SK_Bone {
+    std::string name;
+    int node = -1;         // 이 본이 바인드된 노드 인덱스 (= BoneNodes()[i])
+};
+
+struct SK_Part {
+    SkinnedMesh mesh;
+    std::vector<MaterialGPU> materials;
+    int ownerNode = -1;     // 파트가 붙는 노드
+    std::vector<SK_BoneBox> boneBoxes;          // 이 파트 정점에 영향 주는 본만
+};
+
+class SkeletonAsset
+{
+public:
+    // FBX(쿡 파일 .skel/.anim이 최신이면 그것)에서 계층/본/파트/클립 + GPU 빌드
+    // (캐시는 ResourceManager가 담당)
+    static std::shared_ptr<const SkeletonAsset> LoadFromFBX(
+        ID3D11Device* dev,
+        const std::wstring& fbxPath,
+        const std::wstring& texDir);
+
+    const std::vector<SK_Node>& Nodes() const noexcept { return mNodes; }
+    const std::vector<int>& Parents() const noexcept { return mParents; } // 위상 순서, 루트 -1
+    const std::vector<PoseMath::PoseTRS>& BindPose() const noexcept { return mBindPose; } // 노드별 bindTRS 연속 배열
+    const std::vector<Matrix>& BindGlobal() const noexcept { return mBindGlobal; }        // 바인드 포즈 모델 공간
+    // 어떤 클립에도 채널이 없는 서브트리를 뺀 노드 (위상 순서). 나머지는 global = BindGlobal 고정
+    const std::vector<int>& DynamicNodes() const noexcept { return mDynamicNodes; }
+    const std::vector<SK_Part>& Parts() const noexcept { return mParts; }
+    const std::vector<SK_Bone>& Bones() const noexcept { return mBones; }
+    const std::vector<int>& BoneNodes() const noexcept { return mBoneNodes; }       // 본별 노드 인덱스
+    const std::vector<Matrix>& BoneOffsets() const noexcept { return mBoneOffsets; } // 본별 inverse bind
+    const std::shared_ptr<const AnimClipLibrary>& Clips() const noexcept { return mClips; }
+    const Matrix& GlobalInverse() const noexcept { return mGlobalInv; }
+    int Root() const noexcept { return mRoot; }
+    const std::wstring& SourcePath() const noexcept { return mSourcePath; } // 캐시 키용
+    // 클립을 만든 압축 설정 해시 (CookedSkeleton::AnimOptions). 베이크 캐시 키용
+    uint32_t ClipSettingsHash() const noexcept { return mClipSettingsHash; }
+
+    // 없으면 -1
+    int FindNode(const std::string& name) const;
+
+private:
+    std::vector<SK_Node> mNodes;      // 위상 순서 (부모 인덱스 < 자식 인덱스)
+    std::vector<int> mParents;        // 노드별 부모 인덱스 (평탄화)
+    std::vector<PoseMath::PoseTRS> mBindPose;
+    std::vector<Matrix> mBindGlobal;
+    std::vector<int> mDynamicNodes;
+    std::vector<SK_Part> mParts;
+    std::vector<SK_Bone> mBones;
+    std::vector<int> mBoneNodes;
+    std::vector<Matrix> mBoneOffsets; // aiBone::mOffsetMatrix
+    std::shared_ptr<const AnimClipLibrary> mClips; // FBX의 모든 클립
+    std::unordered_map<std::string, int> mNameToNode;
+    Matrix mGlobalInv = Matrix::Identity;
+    int mRoot = 0;
+    std::wstring mSourcePath;
+    uint32_t mClipSettingsHash = 0;
+};
+
+// 인스턴스별 가변 상태 (에셋 하나를 여러 인스턴스가 공유)
+struct PoseInstance
+{
+    std::shared_ptr<const AnimClip> clip;  // 현재 클립 (null = 바인드 포즈)
+    std::vector<AnimCursor> cursors;       // 채널 인덱스 -> 키 커서
+    double timeSec = 0.0;                  // 마지막으로 평가한 시간
+
+    std::vector<PoseMath::PoseTRS> local;  // 노드별 로컬 포즈 (TRS)
+    std::vector<Matrix> global;            // 노드별 모델 공간 포즈 (정적 노드는 Init 때 한 번)
+    std::vector<PoseMath::BoneMatrix> palette; // 본별 offset * global (3x4, HLSL 업로드 형태)
+    uint32_t paletteBase = 0;              // BonePaletteBuffer 안 상주 슬라이스의 시작 오프셋
+    DirectX::BoundingBox bounds;           // 모델 공간 AABB (본별 박스 x 팔레트, 평가마다 O(본))
+
+    // 버퍼 크기를 에셋에 맞추고 바인드 포즈로 초기화
+    void Init(const SkeletonAsset& asset);
+    size_t MemoryBytes() const;
+};
@@ -0,0 +1,236 @@
+﻿// SkeletonImport.cpp
+#include "SkeletonImport.h"
+#include "AssimpImporterEX.h"
+#include "CookedFile.h"   // ToUtf8
+#include "SkinInfluences.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+// aiMatrix4x4(열벡터, 행우선) -> 행벡터 배치 (SimpleMath::Matrix와 같음)
+static DirectX::XMFLOAT4X4 ToM(const aiMatrix4x4& A)
+{
+	return DirectX::XMFLOAT4X4(
+		A.a1, A.b1, A.c1, A.d1,
+		A.a2, A.b2, A.c2, A.d2,
+		A.a3, A.b3, A.c3, A.d3,
+		A.a4, A.b4, A.c4, A.d4
+	);
+}
+
+unsigned SkeletonImport::ImportFlags()
+{
+	return aiProcess_Triangulate
+		| aiProcess_JoinIdenticalVertices
+		| aiProcess_ImproveCacheLocality
+		| aiProcess_SortByPType
+		| aiProcess_CalcTangentSpace
+		| aiProcess_GenNormals
+		| aiProcess_ConvertToLeftHanded
+		| aiProcess_FlipUVs;
+}
+
+// 공통 정점 성분 (PNTT). 탄젠트 w = handedness
+template<class V>
+static void FillPNTT(const aiMesh* am, unsigned v, V& vv)
+{
+	vv.px = am->mVertices[v].x;
+	vv.py = am->mVertices[v].y;
+	vv.pz = am->mVertices[v].z;
+
+	if (am->mNormals) { vv.nx = am->mNormals[v].x; vv.ny = am->mNormals[v].y; vv.nz = am->mNormals[v].z; }
+	else { vv.nx = 0; vv.ny = 1; vv.nz = 0; }
+
+	if (am->mTextureCoords[0]) { vv.u = am->mTextureCoords[0][v].x; vv.v = am->mTextureCoords[0][v].y; }
+	else { vv.u = vv.v = 0.0f; }
+
+	if (am->mTangents && am->mBitangents) {
+		const aiVector3D& T = am->mTangents[v];
+		const aiVector3D& B = am->mBitangents[v];
+		// cross(N, T) . B
+		const float cx = vv.ny * T.z - vv.nz * T.y;
+		const float cy = vv.nz * T.x - vv.nx * T.z;
+		const float cz = vv.nx * T.y - vv.ny * T.x;
+		const float sign = ((cx * B.x + cy * B.y + cz * B.z) < 0.0f) ? -1.0f : 1.0f;
+		vv.tx = T.x; vv.ty = T.y; vv.tz = T.z; vv.tw = sign;
+	}
+	else { vv.tx = 1; vv.ty = 0; vv.tz = 0; vv.tw = 1; }
+}
+
+void SkeletonImport::FromFBX(const std::wstring& fbxPath, bool skinned, const AnimCompressSettings& cs, SkeletonCPU& out,
+	unsigned maxWorkers)
+{
+	Assimp::Importer imp;
+	const aiScene* sc = imp.ReadFile(CookedFile::ToUtf8(fbxPath), ImportFlags()); // Assimp 경로는 UTF-8
+	FromScene(sc, skinned, cs, out, maxWorkers);
+}
+
+void SkeletonImport::FromScene(const aiScene* sc, bool skinned, const AnimCompressSettings& cs, SkeletonCPU& out,
+	unsigned maxWorkers)
+{
+	if (!sc || !sc->mRootNode) throw std::runtime_error("Assimp load failed");
+
+	out = SkeletonCPU{};
+	out.skinned = skinned;
+	const DirectX::XMFLOAT4X4 rootM = ToM(sc->mRootNode->mTransformation);
+	DirectX::XMStoreFloat4x4(&out.globalInv, DirectX::XMMatrixInverse(nullptr, DirectX::XMLoadFloat4x4(&rootM)));
+
+	// --- 1) 노드 트리 (DFS: 부모가 항상 앞) ---
+	std::unordered_map<std::string, int> nameToIdx;
+	std::function<void(const aiNode*, int)> buildNode = [&](const aiNode* an, int parent) {
+		SkeletonCPU::Node nd;
+		nd.name = an->mName.C_Str();
+		nd.parent = parent;
+		nd.bindLocal = ToM(an->mTransformation);
+		const int my = (int)out.nodes.size();
+		nameToIdx[nd.name] = my;
+		out.nodes.push_back(std::move(nd));
+		for (unsigned c = 0; c < an->mNumChildren; ++c) buildNode(an->mChildren[c], my);
+		};
+	buildNode(sc->mRootNode, -1);
+
+	// --- 2) 재질 ---
+	AssimpImporterEx::ExtractMaterials(sc, out.materials);
+
+	// --- 3-a) 직렬: 메시 순서 확정 + 본 등록 (본 인덱스가 로드마다 같도록 순회 순서 그대로) ---
+	struct MeshJob {
+		const aiMesh* am = nullptr;
+		std::vector<InfluenceSpan> spans;     // 본별 가중치 목록 (aiBone 배열을 그대로 가리킴)
+	};
+	std::vector<MeshJob> jobs;
+	jobs.reserve(sc->mNumMeshes);
+	std::unordered_map<std::string, int> boneNameToIndex;
+
+	auto registerMesh = [&](unsigned meshIndex, int ownerNode) {
+		MeshJob job;
+		job.am = sc->mMeshes[meshIndex];
+
+		SkeletonCPU::Part part;
+		part.ownerNode = ownerNode;
+		part.materialIndex = job.am->mMaterialIndex;
+
+		for (unsigned b = 0; skinned && b < job.am->mNumBones; ++b) {
+			const aiBone* ab = job.am->mBones[b];
+			std::string bname = ab->mName.C_Str();
+
+			int boneIdx;
+			auto itB = boneNameToIndex.find(bname);
+			if (itB == boneNameToIndex.end()) {
+				// map to node
+				auto itNode = nameToIdx.find(bname);
+				if (itNode == nameToIdx.end()) {
+					throw std::runtime_error(("Bone node not found: " + bname).c_str());
+				}
+				boneIdx = (int)out.bones.size();
+				if (boneIdx > 0xFFFF) {
+					throw std::runtime_error("Too many bones (VertexCPU_PNTT_BW::bi is 16-bit)");
+				}
+				SkeletonCPU::Bone bone;
+				bone.name = bname;
+				bone.node = itNode->second;
+				bone.offset = ToM(ab->mOffsetMatrix);
+				out.bones.push_back(std::move(bone));
+				boneNameToIndex[bname] = boneIdx;
+			}
+			else {
+				boneIdx = itB->second;
+			}
+
+			job.spans.push_back({ (uint32_t)boneIdx, ab->mWeights, ab->mNumWeights });
+		}
+		jobs.push_back(std::move(job));
+		out.parts.push_back(std::move(part));
+		};
+
+	std::function<void(const aiNode*)> collectMeshes = [&](const aiNode* an) {
+		const int owner = nameToIdx[an->mName.C_Str()];
+		for (unsigned m = 0; m < an->mNumMeshes; ++m) registerMesh(an->mMeshes[m], owner);
+		for (unsigned c = 0; c < an->mNumChildren; ++c) collectMeshes(an->mChildren[c]);
+		};
+	collectMeshes(sc->mRootNode);
+
+	// --- 3-b) 병렬: 파트별 정점/인덱스/가중치/본 박스 (공유 상태는 읽기만, 결과는 각 파트에) ---
+	const size_t boneCount = out.bones.size();
+	auto buildRigid = [&](const MeshJob& job, SkeletonCPU::Part& part) {
+		const aiMesh* am = job.am;
+		part.rigidVertices.resize(am->mNumVertices);
+		for (unsigned v = 0; v < am->mNumVertices; ++v) FillPNTT(am, v, part.rigidVertices[v]);
+
+		// aiMesh 하나 = 서브메시 하나 (면 인덱스 그대로)
+		part.indices.reserve(am->mNumFaces * 3);
+		for (unsigned f = 0; f < am->mNumFaces; ++f) {
+			const aiFace& face = am->mFaces[f];
+			for (unsigned k = 0; k < face.mNumIndices; ++k)
+				part.indices.push_back(static_cast<uint32_t>(face.mIndices[k]));
+		}
+		};
+	auto buildSkinned = [&](const MeshJob& job, SkeletonCPU::Part& part, InfluenceScratch& scratch) {
+		const aiMesh* am = job.am;
+		std::vector<VertexCPU_PNTT_BW>& vtx = part.skinnedVertices;
+		vtx.resize(am->mNumVertices);
+		for (unsigned v = 0; v < am->mNumVertices; ++v) FillPNTT(am, v, vtx[v]);
+
+		part.indices.reserve(am->mNumFaces * 3);
+		for (unsigned f = 0; f < am->mNumFaces; ++f) {
+			const aiFace& face = am->mFaces[f];
+			if (face.mNumIndices == 3) {
+				part.indices.push_back(face.mIndices[0]);
+				part.indices.push_back(face.mIndices[1]);
+				part.indices.push_back(face.mIndices[2]);
+			}
+		}
+
+		// influences: CSR 2패스 -> 정점별 top-4 (bi/bw 전부 기록)
+		SkinInfluences::GatherTop4(job.spans.data(), job.spans.size(), am->mNumVertices, vtx.data(), scratch);
+
+		// 본별 바인드 AABB: 이 본이 (가중치 > 0으로) 움직이는 정점만
+		std::vector<DirectX::XMFLOAT3> bmn(boneCount, DirectX::XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX));
+		std::vector<DirectX::XMFLOAT3> bmx(boneCount, DirectX::XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX));
+		for (const auto& vv : vtx) {
+			for (int k = 0; k < 4; ++k) {
+				if (vv.bw[k] <= 0.0f) continue;
+				DirectX::XMFLOAT3& mn = bmn[vv.bi[k]];
+				DirectX::XMFLOAT3& mx = bmx[vv.bi[k]];
+				mn.x = (std::min)(mn.x, vv.px); mn.y = (std::min)(mn.y, vv.py); mn.z = (std::min)(mn.z, vv.pz);
+				mx.x = (std::max)(mx.x, vv.px); mx.y = (std::max)(mx.y, vv.py); mx.z = (std::max)(mx.z, vv.pz);
+			}
+		}
+		for (size_t b = 0; b < boneCount; ++b) {
+			if (bmn[b].x > bmx[b].x) continue; // 이 파트에 영향 없음
+			SK_BoneBox bb;
+			bb.bone = (uint32_t)b;
+			bb.center = { (bmn[b].x + bmx[b].x) * 0.5f, (bmn[b].y + bmx[b].y) * 0.5f, (bmn[b].z + bmx[b].z) * 0.5f };
+			bb.extents = { (bmx[b].x - bmn[b].x) * 0.5f, (bmx[b].y - bmn[b].y) * 0.5f, (bmx[b].z - bmn[b].z) * 0.5f };
+			part.boneBoxes.push_back(bb);
+		}
+		};
+
+	{
+		const auto t0 = std::chrono::steady_clock::now();
+		// 임포트 동안만 쓰는 풀 (메시가 하나거나 maxWorkers = 0이면 스레드를 만들지 않음)
+		WorkerPool pool(jobs.size() > 1 ? (std::min)(maxWorkers, (unsigned)jobs.size() - 1) : 0u);
+		pool.ParallelFor(jobs.size(), 1, [&](size_t b, size_t e) {
+			InfluenceScratch scratch; // 청크 안의 메시끼리 재사용
+			for (size_t i = b; i < e; ++i) {
+				if (skinned) buildSkinned(jobs[i], out.parts[i], scratch);
+				else buildRigid(jobs[i], out.parts[i]);
+			}
+			});
+		out.partBuildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+	}
+
+	// --- 4) 애니메이션: FBX의 모든 클립 ---
+	// 노드 부모를 넘겨 계층 높이별 허용 오차를 쓴다
+	std::vector<int> parents(out.nodes.size());
+	for (size_t i = 0; i < out.nodes.size(); ++i) parents[i] = out.nodes[i].parent;
+	out.clips = AnimClipLibrary::FromAssimp(sc, nameToIdx, out.nodes.size(), cs, parents.data());
+}
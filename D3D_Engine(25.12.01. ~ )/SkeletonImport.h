@@ -0,0 +1,75 @@
+﻿// SkeletonImport.h
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <DirectXMath.h>
+
+#include "MeshDataEx.h"
+#include "AnimClip.h"
+
+struct aiScene;
+
+//================================================================================================
+// FBX -> 스켈레톤 CPU 데이터 — RigidSkeletal / SkeletonAsset / 쿡 파일(.skel) 공용
+//  - 노드는 DFS 순서 (부모 인덱스 < 자식 인덱스). 행렬은 SimpleMath::Matrix와 같은 배치.
+//  - rigid  : 파트 정점은 VertexCPU_PNTT.
+//  - skinned: VertexCPU_PNTT_BW + 본 테이블 + 본별 바인드 AABB.
+//    본 등록은 직렬(순회 순서 = 본 인덱스), 파트별 정점/가중치는 메시 단위 병렬 (워커 수는 호출측이 정함).
+//  - GPU 빌드는 각 로더가 한다. 여기는 D3D 의존 없음.
+//================================================================================================
+
+// 본 하나가 영향을 주는 정점들(가중치 > 0)의 바인드(메시) 공간 AABB
+struct SK_BoneBox {
+    uint32_t bone = 0;
+    DirectX::XMFLOAT3 center{ 0, 0, 0 };
+    DirectX::XMFLOAT3 extents{ 0, 0, 0 };
+};
+
+struct SkeletonCPU
+{
+    struct Node {
+        std::string name;
+        int parent = -1;
+        DirectX::XMFLOAT4X4 bindLocal;
+    };
+    struct Bone {
+        std::string name;
+        int node = -1;
+        DirectX::XMFLOAT4X4 offset;          // aiBone::mOffsetMatrix (inverse bind)
+    };
+    struct Part {
+        int ownerNode = -1;
+        uint32_t materialIndex = 0;
+        std::vector<VertexCPU_PNTT> rigidVertices;       // rigid일 때
+        std::vector<VertexCPU_PNTT_BW> skinnedVertices;  // skinned일 때
+        std::vector<uint32_t> indices;
+        std::vector<SK_BoneBox> boneBoxes;               // skinned일 때
+    };
+
+    bool skinned = false;
+    DirectX::XMFLOAT4X4 globalInv;
+    std::vector<Node> nodes;
+    std::vector<Bone> bones;
+    std::vector<Part> parts;                 // 노드 순회 순서
+    std::vector<MaterialCPU> materials;      // 씬 전체 머티리얼
+    std::shared_ptr<const AnimClipLibrary> clips;
+
+    double partBuildMs = 0.0;                // 임포트 시 파트 정점/가중치 빌드 시간 (로그용)
+};
+
+namespace SkeletonImport
+{
+    // FromFBX가 ReadFile에 넘기는 후처리 플래그 (씬을 직접 읽어 FromScene에 넘길 때 같은 값을 쓴다)
+    unsigned ImportFlags();
+
+    // Assimp 임포트 + 추출. 실패하면 std::runtime_error (임포트 실패 / 본 노드 없음 / 본 65536개 초과)
+    //  maxWorkers: 파트 빌드에 쓸 추가 스레드 상한 (0 = 호출 스레드만. 이미 병렬로 도는 쿠커 등)
+    void FromFBX(const std::wstring& fbxPath, bool skinned, const AnimCompressSettings& cs, SkeletonCPU& out,
+        unsigned maxWorkers);
+
+    // 이미 읽은 씬에서 추출 (ImportFlags()로 읽은 씬. 씬은 읽기만 한다)
+    void FromScene(const aiScene* sc, bool skinned, const AnimCompressSettings& cs, SkeletonCPU& out,
+        unsigned maxWorkers);
+}
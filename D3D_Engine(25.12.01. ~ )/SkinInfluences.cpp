@@ -0,0 +1,70 @@
+﻿// SkinInfluences.cpp
+// (pch 없이 빌드: 오프라인 쿠커와 공용)
+#include "SkinInfluences.h"
+
+// 상위 4개 -> 정규화해서 기록 (예전 Influences::finalize와 같은 규칙)
+static void WriteTop4(const uint16_t bi[4], const float bw[4], int n, VertexCPU_PNTT_BW& v)
+{
+	float sum = 0.0f;
+	for (int k = 0; k < 4; ++k) {
+		v.bi[k] = (k < n) ? bi[k] : 0;
+		v.bw[k] = (k < n) ? bw[k] : 0.0f;
+		sum += v.bw[k];
+	}
+	if (sum > 0.0f) {
+		for (int k = 0; k < 4; ++k) v.bw[k] /= sum;
+	}
+	else {
+		v.bi[0] = 0; v.bw[0] = 1.0f;
+		for (int k = 1; k < 4; ++k) { v.bi[k] = 0; v.bw[k] = 0.0f; }
+	}
+}
+
+void SkinInfluences::GatherTop4(const InfluenceSpan* spans, size_t spanCount, uint32_t vertexCount,
+	VertexCPU_PNTT_BW* vtx, InfluenceScratch& s)
+{
+	// 1) 정점별 개수 (offsets[v + 1])
+	s.offsets.assign(size_t(vertexCount) + 1, 0);
+	for (size_t i = 0; i < spanCount; ++i) {
+		const InfluenceSpan& sp = spans[i];
+		for (uint32_t w = 0; w < sp.count; ++w) {
+			const aiVertexWeight& vw = sp.weights[w];
+			if (vw.mVertexId < vertexCount && vw.mWeight > 0.0f) ++s.offsets[vw.mVertexId + 1];
+		}
+	}
+
+	// 2) prefix sum -> 행 시작
+	for (uint32_t v = 0; v < vertexCount; ++v) s.offsets[v + 1] += s.offsets[v];
+	const uint32_t total = s.offsets[vertexCount];
+	s.bones.resize(total);
+	s.weights.resize(total);
+
+	// 3) 채우기 (본 순서대로라 행 안에서도 결정적)
+	s.cursor.assign(s.offsets.begin(), s.offsets.end() - 1);
+	for (size_t i = 0; i < spanCount; ++i) {
+		const InfluenceSpan& sp = spans[i];
+		for (uint32_t w = 0; w < sp.count; ++w) {
+			const aiVertexWeight& vw = sp.weights[w];
+			if (vw.mVertexId >= vertexCount || !(vw.mWeight > 0.0f)) continue;
+			const uint32_t k = s.cursor[vw.mVertexId]++;
+			s.bones[k] = (uint16_t)sp.bone;
+			s.weights[k] = vw.mWeight;
+		}
+	}
+
+	// 4) 행마다 top-4 (고정 배열 삽입 정렬, 큰 것부터)
+	for (uint32_t v = 0; v < vertexCount; ++v) {
+		uint16_t bi[4] = {};
+		float bw[4] = {};
+		int n = 0;
+		for (uint32_t k = s.offsets[v]; k < s.offsets[v + 1]; ++k) {
+			const float w = s.weights[k];
+			if (n == 4 && w <= bw[3]) continue;
+			int j = (n < 4) ? n++ : 3;
+			while (j > 0 && bw[j - 1] < w) { bw[j] = bw[j - 1]; bi[j] = bi[j - 1]; --j; }
+			bw[j] = w;
+			bi[j] = s.bones[k];
+		}
+		WriteTop4(bi, bw, n, vtx[v]);
+	}
+}
@@ -0,0 +1,37 @@
+﻿// SkinInfluences.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <assimp/mesh.h>
+
+#include "MeshDataEx.h"
+
+//================================================================================================
+// 스킨 가중치 수집 (임포트용) — 본별 (정점, 가중치) 목록 -> 정점별 상위 4개
+//  - 2패스 CSR: 정점별 개수 -> prefix sum -> 평탄 배열에 채우기 -> 행마다 고정 배열로 top-4.
+//    정점마다 힙 할당/정렬이 없고, 스크래치는 메시끼리 재사용.
+//  - 결과는 VertexCPU_PNTT_BW::bi/bw에 기록 (가중치 합 1로 정규화, 영향 없으면 본 0 / 1.0).
+//  - 메시 하나는 한 스레드에서. 메시끼리는 스크래치만 따로 두면 병렬 가능.
+//================================================================================================
+struct InfluenceSpan
+{
+    uint32_t bone = 0;                      // 전역 본 인덱스
+    const aiVertexWeight* weights = nullptr; // aiBone::mWeights
+    uint32_t count = 0;
+};
+
+struct InfluenceScratch
+{
+    std::vector<uint32_t> offsets;  // 정점별 행 시작 (vertexCount + 1)
+    std::vector<uint32_t> cursor;   // 채우기 위치
+    std::vector<uint16_t> bones;    // 평탄 (본, 가중치)
+    std::vector<float>    weights;
+};
+
+namespace SkinInfluences
+{
+    void GatherTop4(const InfluenceSpan* spans, size_t spanCount, uint32_t vertexCount,
+        VertexCPU_PNTT_BW* vtx, InfluenceScratch& scratch);
+}
@@ -2,15 +2,77 @@
 #include "../D3D_Core/pch.h"
 #include "SkinnedMesh.h"
 
+#include <cmath>
+#include <DirectXPackedVector.h>
+
+// 단위 벡터 -> 팔면체 [-1, 1]^2
+static void OctEncode(float x, float y, float z, float& u, float& v)
+{
+    const float s = std::fabs(x) + std::fabs(y) + std::fabs(z);
+    if (s <= 0.0f) { u = 0.0f; v = 0.0f; return; } // 길이 0: +Z
+    x /= s; y /= s;
+    if (z < 0.0f) {
+        const float ox = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        const float oy = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = ox; y = oy;
+    }
+    u = x; v = y;
+}
+
+static uint32_t QuantizeUnorm(float s, uint32_t maxQ) // s in [-1, 1]
+{
+    const float f = std::clamp(s * 0.5f + 0.5f, 0.0f, 1.0f);
+    return (uint32_t)std::lround(f * maxQ);
+}
+
+// 가중치 UNORM8: 반올림 후 합이 255가 안 되면 차이를 가장 큰 가중치에 몰아 정확히 1로
+static void QuantizeWeights(const float w[4], uint8_t out[4])
+{
+    int q[4], sum = 0, big = 0;
+    for (int k = 0; k < 4; ++k) {
+        q[k] = (int)std::lround(std::clamp(w[k], 0.0f, 1.0f) * 255.0f);
+        sum += q[k];
+        if (w[k] > w[big]) big = k;
+    }
+    q[big] = std::clamp(q[big] + (255 - sum), 0, 255);
+    for (int k = 0; k < 4; ++k) out[k] = (uint8_t)q[k];
+}
+
+static VertexGPU_Skinned PackSkinned(const VertexCPU_PNTT_BW& v)
+{
+    VertexGPU_Skinned o{};
+    o.px = v.px; o.py = v.py; o.pz = v.pz;
+
+    float u, w;
+    OctEncode(v.nx, v.ny, v.nz, u, w);
+    o.n[0] = (int16_t)std::lround(std::clamp(u, -1.0f, 1.0f) * 32767.0f);
+    o.n[1] = (int16_t)std::lround(std::clamp(w, -1.0f, 1.0f) * 32767.0f);
+
+    OctEncode(v.tx, v.ty, v.tz, u, w);
+    o.t[0] = (uint16_t)QuantizeUnorm(u, 0xFFFF);
+    o.t[1] = (uint16_t)((QuantizeUnorm(w, 0x7FFF) << 1) | (v.tw < 0.0f ? 1u : 0u));
+
+    o.uv[0] = DirectX::PackedVector::XMConvertFloatToHalf(v.u);
+    o.uv[1] = DirectX::PackedVector::XMConvertFloatToHalf(v.v);
+
+    for (int k = 0; k < 4; ++k) o.bi[k] = v.bi[k];
+    QuantizeWeights(v.bw, o.bw);
+    return o;
+}
+
 bool SkinnedMesh::Build(ID3D11Device* dev,
     const std::vector<VertexCPU_PNTT_BW>& vtx,
     const std::vector<uint32_t>& idx,
     const std::vector<SubMeshCPU>& submeshes)
 {
+    // 업로드 형식으로 압축 (72B -> 36B)
+    std::vector<VertexGPU_Skinned> packed(vtx.size());
+    for (size_t i = 0; i < vtx.size(); ++i) packed[i] = PackSkinned(vtx[i]);
+
     D3D11_BUFFER_DESC vb{}; vb.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    vb.ByteWidth = (UINT)(vtx.size() * sizeof(VertexCPU_PNTT_BW));
+    vb.ByteWidth = (UINT)(packed.size() * sizeof(VertexGPU_Skinned));
     vb.Usage = D3D11_USAGE_IMMUTABLE;
-    D3D11_SUBRESOURCE_DATA vsd{ vtx.data(),0,0 };
+    D3D11_SUBRESOURCE_DATA vsd{ packed.data(),0,0 };
     if (FAILED(dev->CreateBuffer(&vb, &vsd, mVB.GetAddressOf()))) return false;
 
     D3D11_BUFFER_DESC ib{}; ib.BindFlags = D3D11_BIND_INDEX_BUFFER;
@@ -8,6 +8,7 @@
 
 class SkinnedMesh {
 public:
+    // vtx는 GPU 업로드 전에 VertexGPU_Skinned(36B)로 압축된다
     bool Build(ID3D11Device* dev,
         const std::vector<VertexCPU_PNTT_BW>& vtx,
         const std::vector<uint32_t>& idx,
@@ -18,6 +19,6 @@ public:
 
 private:
     Microsoft::WRL::ComPtr<ID3D11Buffer> mVB, mIB;
-    UINT mStride = sizeof(VertexCPU_PNTT_BW);
+    UINT mStride = sizeof(VertexGPU_Skinned);
     std::vector<SubMeshCPU> mRanges;
 };
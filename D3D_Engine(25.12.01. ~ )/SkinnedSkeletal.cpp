@@ -3,14 +3,11 @@
 #include "../D3D_Core/Helper.h"
 
 #include "SkinnedSkeletal.h"
-#include "AssimpImporterEX.h"
+#include "ResourceManager.h"
 #include "RenderSharedCB.h"
+#include "PoseMath.h"
 
-#include <assimp/Importer.hpp>
-#include <assimp/scene.h>
-#include <assimp/postprocess.h>
-
-
+#include <cfloat>
 
 static inline double fmod_pos(double x, double m) {
 	if (m <= 0.0) return 0.0;
@@ -18,378 +15,255 @@ static inline double fmod_pos(double x, double m) {
 	return (r < 0.0) ? r + m : r;
 }
 
-static Matrix ToM(const aiMatrix4x4& A)
+// ===== 생성 =====
+std::unique_ptr<SkinnedSkeletal> SkinnedSkeletal::LoadFromFBX(
+	ID3D11Device* /*dev*/,
+	const std::wstring& fbxPath,
+	const std::wstring& texDir)
 {
-	return Matrix(
-		A.a1, A.b1, A.c1, A.d1,
-		A.a2, A.b2, A.c2, A.d2,
-		A.a3, A.b3, A.c3, A.d3,
-		A.a4, A.b4, A.c4, A.d4
-	);
+	// 에셋은 ResourceManager 캐시 경유: 같은 FBX면 임포트/GPU 빌드는 한 번뿐
+	// (디바이스도 ResourceManager 것을 사용)
+	return CreateInstance(ResourceManager::Instance().LoadSkeletonAsset(fbxPath, texDir));
 }
-static Quaternion ToQ(const aiQuaternion& q) { return Quaternion(q.x, q.y, q.z, q.w); }
-static Vector3    ToV3(const aiVector3D& v) { return { v.x, v.y, v.z }; }
 
-static unsigned MakeFlags(bool flipUV, bool leftHanded)
+std::unique_ptr<SkinnedSkeletal> SkinnedSkeletal::CreateInstance(
+	std::shared_ptr<const SkeletonAsset> asset)
 {
-	unsigned f = aiProcess_Triangulate
-		| aiProcess_JoinIdenticalVertices
-		| aiProcess_ImproveCacheLocality
-		| aiProcess_SortByPType
-		| aiProcess_CalcTangentSpace
-		| aiProcess_GenNormals;
-	if (leftHanded) f |= aiProcess_ConvertToLeftHanded;
-	if (flipUV)     f |= aiProcess_FlipUVs;
-	return f;
+	if (!asset) return nullptr;
+
+	auto up = std::unique_ptr<SkinnedSkeletal>(new SkinnedSkeletal());
+	up->mAsset = std::move(asset);
+	up->SetClip(0);
+	up->mPose.Init(*up->mAsset);
+	return up;
 }
 
-// ===== 키프레임 upper bound =====
-int SkinnedSkeletal::UB_T(double t, const std::vector<SK_KeyT>& v)
+SkinnedSkeletal::~SkinnedSkeletal()
 {
-	int n = (int)v.size();
-	int i = 0; while (i < n && v[i].t <= t) ++i; return i;
+	if (mPaletteBuf && mPaletteBuf->Generation() == mPaletteGen)
+		mPaletteBuf->Free(mPose.paletteBase, (uint32_t)mPose.palette.size());
 }
-int SkinnedSkeletal::UB_R(double t, const std::vector<SK_KeyR>& v)
+
+// ===== 클립 전환 =====
+bool SkinnedSkeletal::SetClip(size_t index)
 {
-	int n = (int)v.size();
-	int i = 0; while (i < n && v[i].t <= t) ++i; return i;
+	const auto& clips = mAsset->Clips();
+	if (!clips || index >= clips->Count()) return false;
+	mPose.clip = clips->Get(index);
+	mClipIndex = index;
+	mPose.cursors.assign(mPose.clip->channels.size(), AnimCursor{}); // 커서는 클립 채널 기준
+	if (mBakeOn) {
+		mBaked = BakeCurrentClip(mBakeSettings);
+		mBakedFrame = nullptr;
+	}
+	return true;
 }
-int SkinnedSkeletal::UB_S(double t, const std::vector<SK_KeyS>& v)
+
+bool SkinnedSkeletal::SetClip(const std::string& name)
 {
-	int n = (int)v.size();
-	int i = 0; while (i < n && v[i].t <= t) ++i; return i;
+	const auto& clips = mAsset->Clips();
+	const int i = clips ? clips->IndexOf(name) : -1;
+	return (i >= 0) && SetClip((size_t)i);
+}
+
+// ===== 포즈 평가 =====
+void SkinnedSkeletal::EvaluatePose(double tSec) {
+	EvaluatePose(tSec, /*loop*/true);
 }
 
-// ===== 로컬 행렬 샘플링 =====
-Matrix SkinnedSkeletal::SampleLocalOf(int nodeIdx, double tTick) const
+void SkinnedSkeletal::EvaluatePose(double tSec, bool loop)
 {
-	const SK_Node& nd = mNodes[nodeIdx];
+	if (mBaked) { EvaluateBaked(tSec, loop); return; }
 
-	Matrix S = Matrix::Identity, R = Matrix::Identity, T = Matrix::Identity;
+	const auto& bind = mAsset->BindPose();
+	const AnimClip* clip = mPose.clip.get();
+	mPose.timeSec = tSec;
 
-	auto it = mClip.map.find(nd.name);
-	if (it == mClip.map.end()) {
-		return nd.bindLocal; // 채널 없으면 바인드 로컬 유지
-	}
-	const SK_Channel& ch = mClip.channels[it->second];
-
-	// T
-	if (!ch.T.empty()) {
-		int ub = UB_T(tTick, ch.T);
-		if (ub <= 0) T = Matrix::CreateTranslation(ch.T.front().v);
-		else if (ub >= (int)ch.T.size()) T = Matrix::CreateTranslation(ch.T.back().v);
-		else {
-			const auto& a = ch.T[ub - 1]; const auto& b = ch.T[ub];
-			double dt = (b.t - a.t); float u = (dt > 0.0) ? float((tTick - a.t) / dt) : 0.0f;
-			T = Matrix::CreateTranslation(a.v + (b.v - a.v) * u);
-		}
-	}
-	else T = Matrix::CreateTranslation(nd.bindLocal.Translation());
-
-	// R
-	if (!ch.R.empty()) {
-		int ub = UB_R(tTick, ch.R);
-		if (ub <= 0) R = Matrix::CreateFromQuaternion(ch.R.front().q);
-		else if (ub >= (int)ch.R.size()) R = Matrix::CreateFromQuaternion(ch.R.back().q);
-		else {
-			const auto& a = ch.R[ub - 1]; const auto& b = ch.R[ub];
-			double dt = (b.t - a.t); float u = (dt > 0.0) ? float((tTick - a.t) / dt) : 0.0f;
-			R = Matrix::CreateFromQuaternion(Quaternion::Slerp(a.q, b.q, u));
-		}
+	if (!clip || clip->duration <= 0.0) {
+		mPose.local = bind;
 	}
-	else R = Matrix::Identity;
-
-	// S
-	if (!ch.S.empty()) {
-		int ub = UB_S(tTick, ch.S);
-		if (ub <= 0) S = Matrix::CreateScale(ch.S.front().v);
-		else if (ub >= (int)ch.S.size()) S = Matrix::CreateScale(ch.S.back().v);
-		else {
-			const auto& a = ch.S[ub - 1]; const auto& b = ch.S[ub];
-			double dt = (b.t - a.t); float u = (dt > 0.0) ? float((tTick - a.t) / dt) : 0.0f;
-			S = Matrix::CreateScale(a.v + (b.v - a.v) * u);
-		}
+	else {
+		const double tps = (clip->ticksPerSec > 0.0) ? clip->ticksPerSec : 25.0;
+		const double T = tSec * tps;               // ticks
+		const double t = loop ? fmod_pos(T, clip->duration)
+			: std::clamp(T, 0.0, clip->duration);
+		// 채널 있는 노드에서 키가 없는 성분: T는 바인드 이동, R/S는 Identity
+		clip->SampleLocalPose((float)t, mPose.cursors.data(), bind.data(), /*bindTWhenMissing*/true,
+			mPose.local.data());
 	}
-	else S = Matrix::Identity;
 
-	return S * R * T;
+	// 글로벌 갱신: 동적 노드만 부모 인덱스 따라 선형 1패스 (TRS -> affine 합성도 이 안에서)
+	const auto& dyn = mAsset->DynamicNodes();
+	PoseMath::LocalToGlobalSubset(mAsset->Parents().data(), dyn.data(), dyn.size(),
+		mPose.local.data(), mPose.global.data());
+
+	// 팔레트는 포즈가 바뀐 이 시점에 한 번만 계산 (업로드는 SyncBonePalette에서 dirty일 때만)
+	ComputeBonePalette();
+	ComputeBounds();
+	mPaletteDirty = true;
 }
 
-// ===== 로드 =====
-std::unique_ptr<SkinnedSkeletal> SkinnedSkeletal::LoadFromFBX(
-	ID3D11Device* dev,
-	const std::wstring& fbxPath,
-	const std::wstring& texDir)
+// ===== 베이크 재생 =====
+std::shared_ptr<const BakedClip> SkinnedSkeletal::BakeCurrentClip(const BakeSettings& bs) const
 {
-	auto up = std::unique_ptr<SkinnedSkeletal>(new SkinnedSkeletal());
-
-	Assimp::Importer imp;
-	unsigned flags = MakeFlags(/*flipUV*/true, /*leftHanded*/true);
-	const aiScene* sc = imp.ReadFile(std::string(fbxPath.begin(), fbxPath.end()), flags);
-	if (!sc || !sc->mRootNode) throw std::runtime_error("Assimp load failed");
-	
-	up->mGlobalInv = ToM(sc->mRootNode->mTransformation).Invert();
-
-	// --- 1) 노드 트리 ---
-	std::vector<SK_Node> nodes;
-	std::unordered_map<std::string, int> nameToIdx;
-
-	std::function<int(const aiNode*, int)> buildNode = [&](const aiNode* an, int parent)->int {
-		SK_Node nd;
-		nd.name = an->mName.C_Str();
-		nd.parent = parent;
-		nd.bindLocal = ToM(an->mTransformation);
-		int my = (int)nodes.size();
-		nodes.push_back(nd);
-		nameToIdx[nd.name] = my;
-
-		for (unsigned c = 0; c < an->mNumChildren; ++c) {
-			int cid = buildNode(an->mChildren[c], my);
-			nodes[my].children.push_back(cid);
-		}
-		return my;
-		};
-	int root = buildNode(sc->mRootNode, -1);
-
-	// --- 2) 재질 ---
-	std::vector<MaterialCPU> sceneMaterials;
-	AssimpImporterEx::ExtractMaterials(sc, sceneMaterials);
-
-	// --- 3) 파트 & 본/가중치 빌드 ---
-	std::vector<SK_Part> parts;
-	parts.reserve(sc->mNumMeshes);
-
-	// 본 이름 -> bone index
-	std::unordered_map<std::string, int> boneNameToIndex;
-	std::vector<SK_Bone> bones;
-
-	struct Influences {
-		std::vector<std::pair<int, float>> inf;
-		void add(int b, float w) { if (w > 0) inf.emplace_back(b, w); }
-		void finalize(uint8_t bi[4], float bw[4]) {
-			std::sort(inf.begin(), inf.end(), [](auto& a, auto& b) {return a.second > b.second;});
-			float sum = 0;
-			for (int i = 0;i < 4;++i) {
-				if (i < (int)inf.size()) { bi[i] = (uint8_t)inf[i].first; bw[i] = inf[i].second; sum += bw[i]; }
-				else { bi[i] = 0; bw[i] = 0; }
-			}
-			if (sum > 0) { for (int i = 0;i < 4;++i) bw[i] /= sum; }
-			else { bi[0] = 0; bw[0] = 1.0f; for (int i = 1;i < 4;++i) { bi[i] = 0;bw[i] = 0; } }
-		}
-	};
-
-	auto buildPartFromAiMesh = [&](unsigned meshIndex, int ownerNode) {
-		const aiMesh* am = sc->mMeshes[meshIndex];
-
-		std::vector<VertexCPU_PNTT_BW> vtx(am->mNumVertices);
-		std::vector<uint32_t> idx; idx.reserve(am->mNumFaces * 3);
-		std::vector<SubMeshCPU> submeshes;
-		submeshes.push_back({ 0,0,(uint32_t)am->mNumFaces * 3, am->mMaterialIndex });
-
-		// prim data
-		for (unsigned v = 0; v < am->mNumVertices; ++v) {
-			auto& vv = vtx[v];
-			vv.px = am->mVertices[v].x;
-			vv.py = am->mVertices[v].y;
-			vv.pz = am->mVertices[v].z;
-
-			if (am->mNormals) { vv.nx = am->mNormals[v].x; vv.ny = am->mNormals[v].y; vv.nz = am->mNormals[v].z; }
-			else { vv.nx = 0; vv.ny = 1; vv.nz = 0; }
-
-			if (am->mTextureCoords[0]) { vv.u = am->mTextureCoords[0][v].x; vv.v = am->mTextureCoords[0][v].y; }
-			else { vv.u = vv.v = 0.0f; }
-
-			if (am->mTangents && am->mBitangents) {
-				Vector3 T(am->mTangents[v].x, am->mTangents[v].y, am->mTangents[v].z);
-				Vector3 B(am->mBitangents[v].x, am->mBitangents[v].y, am->mBitangents[v].z);
-				Vector3 N(vv.nx, vv.ny, vv.nz);			
-
-				float sign = (N.Cross(T).Dot(B) < 0.0f) ? -1.0f : 1.0f;
-				vv.tx = T.x; vv.ty = T.y; vv.tz = T.z; vv.tw = sign;
-			}
-			else { vv.tx = 1; vv.ty = 0; vv.tz = 0; vv.tw = 1; }
-
-			// init skin fields
-			vv.bi[0] = vv.bi[1] = vv.bi[2] = vv.bi[3] = 0;
-			vv.bw[0] = 1.0f; vv.bw[1] = vv.bw[2] = vv.bw[3] = 0.0f;
-		}
-		for (unsigned f = 0; f < am->mNumFaces; ++f) {
-			const aiFace& face = am->mFaces[f];
-			if (face.mNumIndices == 3) {
-				idx.push_back(face.mIndices[0]);
-				idx.push_back(face.mIndices[1]);
-				idx.push_back(face.mIndices[2]);
-			}
-		}
-
-		// collect influences
-		std::vector<Influences> infl(am->mNumVertices);
-		for (unsigned b = 0; b < am->mNumBones; ++b) {
-			const aiBone* ab = am->mBones[b];
-			std::string bname = ab->mName.C_Str();
-
-			int boneIdx;
-			auto itB = boneNameToIndex.find(bname);
-			if (itB == boneNameToIndex.end()) {
-				// map to node
-				auto itNode = nameToIdx.find(bname);
-				if (itNode == nameToIdx.end()) {
-					throw std::runtime_error(("Bone node not found: " + bname).c_str());
-				}
-				SK_Bone bone;
-				bone.name = bname;
-				bone.node = itNode->second;
-				bone.offset = ToM(ab->mOffsetMatrix);
-				boneIdx = (int)bones.size();
-				bones.push_back(bone);
-				boneNameToIndex[bname] = boneIdx;
-			}
-			else {
-				boneIdx = itB->second;
-			}
-
-			for (unsigned w = 0; w < ab->mNumWeights; ++w) {
-				const aiVertexWeight& vw = ab->mWeights[w];
-				if (vw.mVertexId < am->mNumVertices) {
-					infl[vw.mVertexId].add(boneIdx, vw.mWeight);
-				}
-			}
-		}
-		// finalize influences per vertex
-		for (unsigned v = 0; v < am->mNumVertices; ++v) {
-			infl[v].finalize(vtx[v].bi, vtx[v].bw);
+	const AnimClip* clip = mPose.clip.get();
+	if (!clip) return nullptr;
+
+	// 클립은 라이브러리 인덱스로 (이름은 겹치거나 비어 있을 수 있다) + 클립을 만든 압축 설정
+	const std::wstring key = mAsset->SourcePath() + L"|cs" + std::to_wstring(mAsset->ClipSettingsHash())
+		+ L"|c" + std::to_wstring(mClipIndex)
+		+ L"|" + std::to_wstring(bs.fps) + L"|" + std::to_wstring(bs.maxBytes);
+
+	return ResourceManager::Instance().GetOrBakeClip(key, [&]() -> std::shared_ptr<const BakedClip> {
+		const auto& parts = mAsset->Parts();
+		const uint32_t bones = (uint32_t)mAsset->Bones().size();
+		const double dur = clip->DurationSec();
+		const uint32_t frames = BakedClip::FrameCount(dur, bones, (uint32_t)parts.size(), bs);
+		if (frames == 0) {
+			LOG_MESSAGEA("Bake '%.40s' skipped (no duration or over %zu KB)", clip->name.c_str(), bs.maxBytes / 1024);
+			return nullptr;
 		}
 
-		// build gpu mesh
-		SK_Part part;
-		if (!part.mesh.Build(dev, vtx, idx, submeshes))
-			throw std::runtime_error("SkinnedMesh build failed");
-
-		// materials
-		part.materials.clear(); part.materials.resize(sceneMaterials.size());
-		for (size_t i = 0; i < sceneMaterials.size(); ++i)
-			part.materials[i].Build(dev, sceneMaterials[i], texDir);
-
-		part.ownerNode = ownerNode;
-		nodes[ownerNode].partIndices.push_back((int)parts.size());
-		parts.push_back(std::move(part));
-		};
-
-	// traverse and build parts
-	std::function<void(const aiNode*)> collectMeshes = [&](const aiNode* an) {
-		int owner = nameToIdx[an->mName.C_Str()];
-		for (unsigned m = 0; m < an->mNumMeshes; ++m) buildPartFromAiMesh(an->mMeshes[m], owner);
-		for (unsigned c = 0; c < an->mNumChildren; ++c) collectMeshes(an->mChildren[c]);
-		};
-	collectMeshes(sc->mRootNode);
-
-	// --- 4) 애니메이션(첫 개) ---
-	SK_Clip clip;
-	if (sc->mNumAnimations > 0) {
-		const aiAnimation* a = sc->mAnimations[0];
-		clip.name = a->mName.C_Str();
-		clip.duration = a->mDuration;
-		clip.tps = (a->mTicksPerSecond > 0.0) ? a->mTicksPerSecond : 25.0;
-
-		clip.channels.reserve(a->mNumChannels);
-		for (unsigned c = 0; c < a->mNumChannels; ++c) {
-			const aiNodeAnim* na = a->mChannels[c];
-			SK_Channel ch; ch.target = na->mNodeName.C_Str();
-			ch.T.reserve(na->mNumPositionKeys);
-			ch.R.reserve(na->mNumRotationKeys);
-			ch.S.reserve(na->mNumScalingKeys);
-			for (unsigned i = 0; i < na->mNumPositionKeys; ++i)
-				ch.T.push_back({ na->mPositionKeys[i].mTime, ToV3(na->mPositionKeys[i].mValue) });
-			for (unsigned i = 0; i < na->mNumRotationKeys; ++i)
-				ch.R.push_back({ na->mRotationKeys[i].mTime, ToQ(na->mRotationKeys[i].mValue) });
-			for (unsigned i = 0; i < na->mNumScalingKeys; ++i)
-				ch.S.push_back({ na->mScalingKeys[i].mTime,  ToV3(na->mScalingKeys[i].mValue) });
-			clip.map[ch.target] = (int)clip.channels.size();
-			clip.channels.push_back(std::move(ch));
+		// 일반 경로 그대로 샘플 (임시 인스턴스, 같은 에셋/클립)
+		auto tmp = CreateInstance(mAsset);
+		tmp->mPose.clip = mPose.clip;
+		tmp->mPose.cursors.assign(clip->channels.size(), AnimCursor{});
+
+		const double step = dur / double(frames - 1);
+		auto baked = std::make_shared<BakedClip>(frames, bones, (uint32_t)parts.size(), float(1.0 / step), dur);
+		for (uint32_t f = 0; f < frames; ++f) {
+			tmp->EvaluatePose(std::min(f * step, dur), /*loop*/false);
+			std::copy(tmp->mPose.palette.begin(), tmp->mPose.palette.end(), baked->Palette(f));
+			Matrix* pg = baked->PartGlobals(f);
+			for (size_t p = 0; p < parts.size(); ++p) pg[p] = tmp->mPose.global[parts[p].ownerNode];
 		}
-	}
 
-	up->mNodes = std::move(nodes);
-	up->mParts = std::move(parts);
-	up->mBones = std::move(bones);
-	up->mNameToNode = std::move(nameToIdx);
-	up->mClip = std::move(clip);
-	up->mRoot = root;
-
-	return up;
+		LOG_MESSAGEA("Baked '%.40s': %u frames @ %.1f fps, %.1f KB%s", clip->name.c_str(),
+			frames, baked->Fps(), baked->MemoryBytes() / 1024.0, (baked->Fps() < bs.fps - 0.01f) ? " (capped)" : "");
+		return baked;
+	});
 }
 
-// ===== 포즈 평가 =====
-void SkinnedSkeletal::EvaluatePose(double tSec) {
-	EvaluatePose(tSec, /*loop*/true);
+bool SkinnedSkeletal::SetBaked(bool on, const BakeSettings& bs)
+{
+	mBakeOn = on;
+	mBakeSettings = bs;
+	mBaked = on ? BakeCurrentClip(bs) : nullptr;
+	mBakedFrame = nullptr;
+	return !on || mBaked != nullptr;
 }
 
-void SkinnedSkeletal::EvaluatePose(double tSec, bool loop)
+void SkinnedSkeletal::EvaluateBaked(double tSec, bool loop)
 {
-	if (mClip.duration <= 0.0) {
-		for (auto& n : mNodes) n.poseLocal = n.bindLocal;
-	}
-	else {
-		const double tps = (mClip.tps > 0.0) ? mClip.tps : 25.0;
-		const double T = tSec * tps;               // ticks
-		const double t = loop ? fmod_pos(T, mClip.duration)
-			: std::clamp(T, 0.0, mClip.duration);
-		for (size_t i = 0; i < mNodes.size(); ++i)
-			mNodes[i].poseLocal = SampleLocalOf((int)i, t);
+	const BakedClip& bk = *mBaked;
+	mPose.timeSec = tSec;
+
+	const double dur = bk.DurationSec();
+	const double t = loop ? fmod_pos(tSec, dur) : std::clamp(tSec, 0.0, dur);
+	const double x = t * bk.Fps();
+	const uint32_t last = bk.Frames() - 1;
+	const uint32_t f0 = std::min((uint32_t)x, last);
+	const uint32_t f1 = std::min(f0 + 1, last);
+	const float a = float(x - f0);
+
+	const auto& parts = mAsset->Parts();
+	if (!mBakedLerp || f0 == f1 || a < 1e-4f) {
+		// 가까운 프레임: 팔레트는 테이블을 그대로 업로드 (복사 0)
+		const uint32_t f = (mBakedLerp || a < 0.5f) ? f0 : f1;
+		mBakedFrame = bk.Palette(f);
+		const Matrix* pg = bk.PartGlobals(f);
+		for (size_t p = 0; p < parts.size(); ++p) mPose.global[parts[p].ownerNode] = pg[p];
+		ComputeBounds();
+		mPaletteDirty = true;
+		return;
 	}
 
-	if (mRoot >= 0) {
-		mNodes[mRoot].poseGlobal = mNodes[mRoot].poseLocal;
-		std::function<void(int)> dfs = [&](int u) {
-			for (int v : mNodes[u].children) {
-				mNodes[v].poseGlobal = mNodes[v].poseLocal * mNodes[u].poseGlobal;
-				dfs(v);
-			}
-			};
-		dfs(mRoot);
-	}
+	mBakedFrame = nullptr;
+	PoseMath::LerpBones(bk.Palette(f0), bk.Palette(f1), a, mPose.palette.data(), bk.Bones());
+	const Matrix* pg0 = bk.PartGlobals(f0);
+	const Matrix* pg1 = bk.PartGlobals(f1);
+	for (size_t p = 0; p < parts.size(); ++p)
+		PoseMath::LerpMatrices(&pg0[p], &pg1[p], a, &mPose.global[parts[p].ownerNode], 1);
+	ComputeBounds();
+	mPaletteDirty = true;
 }
 
-// ===== 본 팔레트 업데이트 =====
-void SkinnedSkeletal::UpdateBonePalette(
-	ID3D11DeviceContext* ctx,
-	ID3D11Buffer* boneCB,
-	const Matrix& /*worldModel*/)
+// ===== 본 팔레트 =====
+void SkinnedSkeletal::ComputeBonePalette()
+{
+	// 본 이름 테이블(Bones)은 안 건드리고 연속 배열 두 개만 읽는다
+	PoseMath::SkinPalette(mAsset->BoneNodes().data(), mAsset->BoneOffsets().data(), mAsset->BoneOffsets().size(),
+		mPose.global.data(), mPose.palette.data());
+}
+
+// ===== 바운드 =====
+// AABB(c, e)를 affine M으로: 중심은 그대로 변환, 반경은 |M| (성분 절댓값)으로
+static void TransformAABB(FXMMATRIX M, FXMVECTOR c, FXMVECTOR e, XMVECTOR& mn, XMVECTOR& mx)
 {
-	// HLSL 쪽 kMaxBones = 256과 반드시 일치시키자
-	static constexpr size_t kMaxBones = 256;
+	XMMATRIX A;
+	A.r[0] = XMVectorAbs(M.r[0]);
+	A.r[1] = XMVectorAbs(M.r[1]);
+	A.r[2] = XMVectorAbs(M.r[2]);
+	A.r[3] = XMVectorZero();
+	const XMVECTOR c2 = XMVector3Transform(c, M);
+	const XMVECTOR e2 = XMVector3TransformNormal(e, A);
+	mn = XMVectorMin(mn, XMVectorSubtract(c2, e2));
+	mx = XMVectorMax(mx, XMVectorAdd(c2, e2));
+}
 
-	// 항상 kMaxBones 개 만큼 업로드할 임시 버퍼 (트랜스포즈 반영)
-	DirectX::XMFLOAT4X4 temp[kMaxBones];
+// 본별 바인드 박스를 현재 팔레트로 옮겨 합치고, 파트 소유 노드 글로벌까지 (O(본), 정점 안 봄).
+// 스키닝 정점 = 영향 본들 변환 결과의 볼록 결합이고, 정점은 영향 본마다 그 본의 박스 안에 있으므로 보수적.
+void SkinnedSkeletal::ComputeBounds()
+{
+	const PoseMath::BoneMatrix* pal = mBakedFrame ? mBakedFrame : mPose.palette.data();
+	const XMVECTOR big = XMVectorReplicate(FLT_MAX);
 
-	const size_t n = std::min(mBones.size(), kMaxBones);
+	XMVECTOR mn = big, mx = XMVectorNegate(big);
+	for (const SK_Part& part : mAsset->Parts()) {
+		if (part.boneBoxes.empty()) continue;
 
-	// 1) 실제 본 개수만큼 계산해서 채우기
-	for (size_t i = 0; i < n; ++i) {
-		const auto& b = mBones[i];
-		const Matrix G = mNodes[b.node].poseGlobal;   // model space
-		const Matrix M = b.offset * G;                // skinning matrix
-		XMStoreFloat4x4(&temp[i], XMMatrixTranspose(M));
-	}
+		XMVECTOR pmn = big, pmx = XMVectorNegate(big);
+		for (const SK_BoneBox& bb : part.boneBoxes)
+			TransformAABB(XMLoadFloat3x4(&pal[bb.bone]), XMLoadFloat3(&bb.center), XMLoadFloat3(&bb.extents), pmn, pmx);
 
-	// 2) 남는 슬롯은 Identity로 패딩
-	for (size_t i = n; i < kMaxBones; ++i) {
-		XMStoreFloat4x4(&temp[i], XMMatrixIdentity());
+		const XMVECTOR c = XMVectorScale(XMVectorAdd(pmn, pmx), 0.5f);
+		const XMVECTOR e = XMVectorScale(XMVectorSubtract(pmx, pmn), 0.5f);
+		TransformAABB(XMLoadFloat4x4(&mPose.global[part.ownerNode]), c, e, mn, mx);
 	}
 
-	// 3) CB 전체 크기만큼 항상 업로드 (크래시 방지 핵심)
-	ctx->UpdateSubresource(boneCB, 0, nullptr, temp, 0, 0);
-	ctx->VSSetConstantBuffers(4, 1, &boneCB); // b4
+	if (XMVector3Greater(mn, mx)) mPose.bounds = BoundingBox(); // 스킨 파트 없음
+	else BoundingBox::CreateFromPoints(mPose.bounds, mn, mx);
 }
 
-// SkinnedSkeletal.cpp
-void SkinnedSkeletal::WarmupBoneCB(ID3D11DeviceContext* ctx, ID3D11Buffer* boneCB)
+uint32_t SkinnedSkeletal::SyncBonePalette(BonePaletteBuffer& palettes)
 {
-	// 1) 바인드 포즈로 평가 (클립이 없으면 bindLocal, 있으면 t=0)
-	EvaluatePose(0.0, /*loop=*/true);
+	const uint32_t count = (uint32_t)mPose.palette.size();
+
+	// 슬라이스가 없거나 버퍼가 바뀌었거나(Release/Init) 다른 버퍼면 새로 받는다
+	if (mPaletteBuf != &palettes || mPaletteGen != palettes.Generation()) {
+		if (mPaletteBuf && mPaletteBuf->Generation() == mPaletteGen)
+			mPaletteBuf->Free(mPose.paletteBase, count);
+		mPaletteBuf = &palettes;
+		mPaletteGen = palettes.Generation();
+		mPose.paletteBase = palettes.Allocate(count);
+		mPaletteDirty = true;
+	}
 
-	// 2) 팔레트 업로드 (항상 256개 패딩)
-	UpdateBonePalette(ctx, boneCB, Matrix::Identity);
+	if (mPaletteDirty) {
+		const PoseMath::BoneMatrix* src = mBakedFrame ? mBakedFrame : mPose.palette.data();
+		palettes.Write(mPose.paletteBase, src, count);
+		mPaletteDirty = false;
+	}
+	return mPose.paletteBase;
+}
+
+void SkinnedSkeletal::BindBonePalette(ID3D11DeviceContext* ctx, ID3D11Buffer* boneCB) const
+{
+	// 팔레트 본체(t7)는 Upload로 이미 올라가 있음. 여기선 내 슬라이스 시작 오프셋만.
+	BoneBaseCB bb{};
+	bb.base = mPose.paletteBase;
+	ctx->UpdateSubresource(boneCB, 0, nullptr, &bb, 0, 0);
+	ctx->VSSetConstantBuffers(4, 1, &boneCB); // b4
 }
 
 static void FillCB(ConstantBuffer& cb,
@@ -431,16 +305,16 @@ void SkinnedSkeletal::DrawOpaqueOnly(
 	const Vector3& /*kA*/, float /*ks*/, float /*shininess*/, const Vector3& /*Ia*/,
 	bool disableNormal, bool disableSpecular, bool disableEmissive)
 {
-	UpdateBonePalette(ctx, boneCB, worldModel);
+	BindBonePalette(ctx, boneCB);
 
-	for (const auto& part : mParts) {
+	for (const auto& part : mAsset->Parts()) {
 		const auto& ranges = part.mesh.Ranges();
 		for (size_t i = 0; i < ranges.size(); ++i) {
 			const auto& r = ranges[i];
 			const auto& mat = part.materials[r.materialIndex];
 			if (mat.hasOpacity) continue; // 불투명 패스: opacity X
 
-			const Matrix world = mNodes[part.ownerNode].poseGlobal * worldModel;
+			const Matrix world = mPose.global[part.ownerNode] * worldModel;
 
 			ConstantBuffer cb{};
 			FillCB(cb, world, view, proj, vLightDir, vLightColor);
@@ -466,16 +340,16 @@ void SkinnedSkeletal::DrawAlphaCutOnly(
 	const Vector3& /*kA*/, float /*ks*/, float /*shininess*/, const Vector3& /*Ia*/,
 	bool disableNormal, bool disableSpecular, bool disableEmissive)
 {
-	UpdateBonePalette(ctx, boneCB, worldModel);
+	BindBonePalette(ctx, boneCB);
 
-	for (const auto& part : mParts) {
+	for (const auto& part : mAsset->Parts()) {
 		const auto& ranges = part.mesh.Ranges();
 		for (size_t i = 0; i < ranges.size(); ++i) {
 			const auto& r = ranges[i];
 			const auto& mat = part.materials[r.materialIndex];
 			if (!mat.hasOpacity) continue; // 컷아웃 패스: opacity 있는 애만
 
-			const Matrix world = mNodes[part.ownerNode].poseGlobal * worldModel;
+			const Matrix world = mPose.global[part.ownerNode] * worldModel;
 
 			ConstantBuffer cb{};
 			FillCB(cb, world, view, proj, vLightDir, vLightColor);
@@ -502,16 +376,16 @@ void SkinnedSkeletal::DrawTransparentOnly(
 	const Vector3& /*kA*/, float /*ks*/, float /*shininess*/, const Vector3& /*Ia*/,
 	bool disableNormal, bool disableSpecular, bool disableEmissive)
 {
-	UpdateBonePalette(ctx, boneCB, worldModel);
+	BindBonePalette(ctx, boneCB);
 
-	for (const auto& part : mParts) {
+	for (const auto& part : mAsset->Parts()) {
 		const auto& ranges = part.mesh.Ranges();
 		for (size_t i = 0; i < ranges.size(); ++i) {
 			const auto& r = ranges[i];
 			const auto& mat = part.materials[r.materialIndex];
 			if (!mat.hasOpacity) continue; // 투명 패스에서 쓰는 경우(직알파) — 상태는 앱에서 세팅
 
-			const Matrix world = mNodes[part.ownerNode].poseGlobal * worldModel;
+			const Matrix world = mPose.global[part.ownerNode] * worldModel;
 
 			ConstantBuffer cb{};
 			FillCB(cb, world, view, proj, vLightDir, vLightColor);
@@ -539,17 +413,17 @@ void SkinnedSkeletal::DrawDepthOnly(
 	ID3D11InputLayout* ilPNTT_BW,
 	float alphaCut)
 {
-	// 본 팔레트(b4) 업데이트
-	UpdateBonePalette(ctx, boneCB, worldModel);
+	// 본 팔레트 오프셋(b4)
+	BindBonePalette(ctx, boneCB);
 
 	ctx->IASetInputLayout(ilPNTT_BW);
 	ctx->VSSetShader(vsDepthSkinned, nullptr, 0);
 	ctx->PSSetShader(psDepth, nullptr, 0);
 
-	for (const auto& part : mParts)
+	for (const auto& part : mAsset->Parts())
 	{
 		const auto& ranges = part.mesh.Ranges();
-		const Matrix world = mNodes[part.ownerNode].poseGlobal * worldModel;
+		const Matrix world = mPose.global[part.ownerNode] * worldModel;
 
 		ConstantBuffer cb{};
 		cb.mWorld = XMMatrixTranspose(world);
@@ -6,64 +6,32 @@
 #include <directxtk/SimpleMath.h>
 #include <d3d11.h>
 
-#include "SkinnedMesh.h"
-#include "Material.h"
+#include "SkeletonAsset.h"
+#include "BonePaletteBuffer.h"
+#include "BakedClip.h"
 
 using namespace DirectX::SimpleMath;
 
-struct SK_Node {
-    std::string name;
-    int parent = -1;
-    std::vector<int> children;
-    Matrix bindLocal = Matrix::Identity;
-    Matrix poseLocal = Matrix::Identity;
-    Matrix poseGlobal = Matrix::Identity;
-    std::vector<int> partIndices;
-};
-
-struct SK_KeyT { double t; Vector3 v; };
-struct SK_KeyR { double t; Quaternion q; };
-struct SK_KeyS { double t; Vector3 v; };
-
-struct SK_Channel {
-    std::string target;
-    std::vector<SK_KeyT> T;
-    std::vector<SK_KeyR> R;
-    std::vector<SK_KeyS> S;
-};
-
-struct SK_Clip {
-    std::string name;
-    double duration = 0.0;
-    double tps = 25.0;
-    std::vector<SK_Channel> channels;
-    std::unordered_map<std::string, int> map; // target -> channel index
-};
-
-struct SK_Bone {
-    std::string name;
-    int node = -1;         //   ε  ε
-    Matrix offset = Matrix::Identity; // aiBone::mOffsetMatrix (inverse bind)
-};
-
-struct SK_Part {
-    SkinnedMesh mesh;
-    std::vector<MaterialGPU> materials;
-    int ownerNode = -1;     // Ʈ ٴ 
-};
-
+// Ű ĳ νϽ:  SkeletonAsset + ڱ PoseInstance .
 class SkinnedSkeletal {
 public:
 	using Matrix = DirectX::SimpleMath::Matrix;
 	using Vector3 = DirectX::SimpleMath::Vector3;
 	using Quaternion = DirectX::SimpleMath::Quaternion;
         
-    const Matrix& GlobalInverse() const { return mGlobalInv; }
+    const Matrix& GlobalInverse() const { return mAsset->GlobalInverse(); }
 
+    //  ResourceManager ĳÿ  ( FBX )
     static std::unique_ptr<SkinnedSkeletal> LoadFromFBX(
         ID3D11Device* dev,
         const std::wstring& fbxPath,
         const std::wstring& texDir);
+    // ̹ ִ  νϽ ߰ (FBX ε )
+    static std::unique_ptr<SkinnedSkeletal> CreateInstance(std::shared_ptr<const SkeletonAsset> asset);
+    ~SkinnedSkeletal(); // ȷƮ ̽ ݳ
+
+    SkinnedSkeletal(const SkinnedSkeletal&) = delete;
+    SkinnedSkeletal& operator=(const SkinnedSkeletal&) = delete;
 
     void EvaluatePose(double tSec); // Rigid 
     void EvaluatePose(double tSec, bool loop);
@@ -101,35 +69,55 @@ public:
         float alphaCut);
 
 
-    //  ȷƮ   boneCB ε
-    void UpdateBonePalette(ID3D11DeviceContext* ctx, ID3D11Buffer* boneCB, const Matrix& worldModel);
-    // SkinnedSkeletal.h (public:)
-    void WarmupBoneCB(ID3D11DeviceContext* ctx, ID3D11Buffer* boneCB);
+    //  (t7)   ̽ ȷƮ ݿ (Ӹ, Draw* ).   ȯ.
+    // ó   ڸ ް,  ȭ   ٲ 쿡 Write (LOD ǳʶ  ε )
+    uint32_t SyncBonePalette(BonePaletteBuffer& palettes);
+    //   boneCB(b4, RenderCB::BoneBase) ε. Draw* ο ȣ
+    void BindBonePalette(ID3D11DeviceContext* ctx, ID3D11Buffer* boneCB) const;
 
 
+    // Ŭ ȯ (̺귯  ͸ ü, Ʈ )
+    bool SetClip(size_t index);
+    bool SetClip(const std::string& name);
+
+    // ߿ ũ :  Ŭ ȷƮ ̺ ̸  ΰ  lerp Ѵ.
+    //   SetClip   Ŭ ũ(ĳ ). ϸ Ϲ ø , false.
+    // ũ ߿ Ʈ    Pose().global ŵ ʴ´.
+    bool SetBaked(bool on, const BakeSettings& bs = {});
+    void SetBakedLerp(bool on) { mBakedLerp = on; }
+    bool BakedLerp() const { return mBakedLerp; }
+    const BakedClip* Baked() const { return mBaked.get(); }
+
     // 
-    double DurationSec() const {
-        return (mClip.tps > 0.0) ? (mClip.duration / mClip.tps)
-            : (mClip.duration / 25.0);
-    }
+    double DurationSec() const { return mPose.clip ? mPose.clip->DurationSec() : 0.0; }
+    const AnimClip* Clip() const { return mPose.clip.get(); }
+    const AnimClipLibrary* Clips() const { return mAsset->Clips().get(); }
+    const std::shared_ptr<const SkeletonAsset>& Asset() const { return mAsset; }
+    const PoseInstance& Pose() const { return mPose; }
+    //   AABB (  ). ø/׸  
+    const DirectX::BoundingBox& Bounds() const { return mPose.bounds; }
 private:
 
-    DirectX::SimpleMath::Matrix mGlobalInv = DirectX::SimpleMath::Matrix::Identity;
     SkinnedSkeletal() = default;
-    static int UB_T(double t, const std::vector<SK_KeyT>& v);
-    static int UB_R(double t, const std::vector<SK_KeyR>& v);
-    static int UB_S(double t, const std::vector<SK_KeyS>& v);
-    Matrix SampleLocalOf(int nodeIdx, double tTick) const;
+    void ComputeBonePalette(); // EvaluatePose   
+    void ComputeBounds();      // ȷƮ  (ũ  )
+    std::shared_ptr<const BakedClip> BakeCurrentClip(const BakeSettings& bs) const;
+    void EvaluateBaked(double tSec, bool loop);
 
 private:
-    std::vector<SK_Node> mNodes;
-    std::vector<SK_Part> mParts;
-    std::vector<SK_Bone> mBones;       
-
-    SK_Clip mClip;
-    int mRoot = 0;
-    std::unordered_map<std::string, int> mNameToNode;
-
-    // ĳ
-    std::vector<Matrix> mBonePalette;   // offset * poseGlobal(node)
+    std::shared_ptr<const SkeletonAsset> mAsset; // Һ, νϽ 
+    PoseInstance mPose;                          // νϽ  
+    size_t mClipIndex = 0;                       // mPose.clip ̺귯 ε (ũ ĳ Ű)
+
+    // ũ 
+    std::shared_ptr<const BakedClip> mBaked;     // null = Ϲ ø
+    BakeSettings mBakeSettings;
+    bool mBakeOn = false;
+    bool mBakedLerp = true;
+    const PoseMath::BoneMatrix* mBakedFrame = nullptr;         // lerp    ̺   ٷ ε
+
+    // ȷƮ ̽ (SyncBonePalette)
+    BonePaletteBuffer* mPaletteBuf = nullptr;   // ̽   (null =  )
+    uint32_t mPaletteGen = 0;                   //    Generation (ٸ ٽ ޴´)
+    bool mPaletteDirty = true;                  //  Sync   ٲ
 };
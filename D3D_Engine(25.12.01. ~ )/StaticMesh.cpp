@@ -4,28 +4,41 @@
 
 bool StaticMesh::Build(ID3D11Device* dev, const MeshData_PNTT& src)
 {
-	assert(!src.vertices.empty());
-	assert(!src.indices.empty());
+    CookedMeshView view;
+    CookedMesh::ViewOf(src, view);
+    return Build(dev, view);
+}
+
+bool StaticMesh::Build(ID3D11Device* dev, const CookedMeshView& src)
+{
+	assert(src.vertexCount > 0);
+	assert(src.indexCount > 0);
 
     D3D11_BUFFER_DESC vb{};	
 
     vb.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    vb.ByteWidth = (UINT)(src.vertices.size() * sizeof(VertexCPU_PNTT));
+    vb.ByteWidth = (UINT)(src.vertexCount * sizeof(VertexCPU_PNTT));
     vb.Usage = D3D11_USAGE_IMMUTABLE;
 
-    D3D11_SUBRESOURCE_DATA vsd{ src.vertices.data(),0,0 };
+    D3D11_SUBRESOURCE_DATA vsd{ src.vertices,0,0 };
     if (FAILED(dev->CreateBuffer(&vb, &vsd, mVB.GetAddressOf()))) return false;
 
     D3D11_BUFFER_DESC ib{};
     ib.BindFlags = D3D11_BIND_INDEX_BUFFER;
-    ib.ByteWidth = (UINT)(src.indices.size() * sizeof(uint32_t));
+    ib.ByteWidth = (UINT)(src.indexCount * sizeof(uint32_t));
     ib.Usage = D3D11_USAGE_IMMUTABLE;
-    D3D11_SUBRESOURCE_DATA isd{ src.indices.data(),0,0 };
+    D3D11_SUBRESOURCE_DATA isd{ src.indices,0,0 };
     if (FAILED(dev->CreateBuffer(&ib, &isd, mIB.GetAddressOf()))) return false;
 
-    mRanges.clear(); mRanges.reserve(src.submeshes.size());
-    for (auto& sm : src.submeshes)
+    mRanges.clear(); mRanges.reserve(src.submeshCount);
+    for (uint32_t i = 0; i < src.submeshCount; ++i) {
+        const SubMeshCPU& sm = src.submeshes[i];
         mRanges.push_back({ sm.indexStart, sm.indexCount, sm.materialIndex });
+    }
+
+    const XMVECTOR mn = XMVectorSet(src.boundsMin[0], src.boundsMin[1], src.boundsMin[2], 0.0f);
+    const XMVECTOR mx = XMVectorSet(src.boundsMax[0], src.boundsMax[1], src.boundsMax[2], 0.0f);
+    BoundingBox::CreateFromPoints(mBounds, mn, mx);
     return true;
 }
 
@@ -3,18 +3,24 @@
 #include <d3d11.h>
 #include <wrl/client.h>
 #include <vector>
+#include <DirectXCollision.h>
 #include "MeshDataEx.h"
+#include "CookedMesh.h"
 
 class StaticMesh {
 public:
     bool Build(ID3D11Device* dev, const MeshData_PNTT& src);
+    // 쿡 파일 매핑(또는 임포트 결과)의 포인터를 그대로 버퍼 초기 데이터로
+    bool Build(ID3D11Device* dev, const CookedMeshView& src);
     void DrawSubmesh(ID3D11DeviceContext* ctx, size_t smIdx) const;
 
     struct Range { UINT indexStart, indexCount, materialIndex; };
     const std::vector<Range>& Ranges() const { return mRanges; }
+    const DirectX::BoundingBox& Bounds() const { return mBounds; } // 모델 공간 AABB
 
 private:
     Microsoft::WRL::ComPtr<ID3D11Buffer> mVB, mIB;
     UINT mStride = sizeof(VertexCPU_PNTT);
     std::vector<Range> mRanges;
+    DirectX::BoundingBox mBounds;
 };
@@ -31,6 +31,9 @@
 #include "Material.h"
 #include "RigidSkeletal.h"
 #include "SkinnedSkeletal.h"
+#include "BonePaletteBuffer.h"
+#include "AnimLOD.h"
+#include "AnimationSystem.h"
 #include "AssimpImporterEx.h"
 #include "ResourceManager.h"
 
@@ -212,7 +215,8 @@ private:
 	//==========================================================================================
 	ID3D11VertexShader* m_pSkinnedVS = nullptr;
 	ID3D11InputLayout* m_pSkinnedIL = nullptr;
-	ID3D11Buffer* m_pBoneCB = nullptr; // VS b4
+	ID3D11Buffer* m_pBoneCB = nullptr; // VS b4 (BoneBaseCB: 팔레트 시작 오프셋)
+	BonePaletteBuffer mBonePalettes;   // VS t7 (스키닝 인스턴스별 상주 슬라이스, 바뀐 구간만 업로드)
 	std::unique_ptr<SkinnedSkeletal>     mSkinRig;               // SkinningTest.fbx
 
 	//==========================================================================================
@@ -268,17 +272,19 @@ private:
 	//==========================================================================================
 	// 애니메이션 컨트롤 (디버그)
 	//==========================================================================================
-	struct AnimCtrl
-	{
-		bool   play = true;
-		bool   loop = true;
-		float  speed = 1.0f;
-		double t = 0.0;
-	};
+	using AnimCtrl = AnimPlayback;
 
 	AnimCtrl mBoxAC;
 	AnimCtrl mSkinAC;
 
+	// 등록된 리그 전부를 워커 풀에서 평가 (OnUpdate에서 Update 한 번, 리턴 전에 join)
+	AnimationSystem mAnimSys;
+
+	// 애니메이션 LOD (화면 크기/가시성 -> 업데이트 주기)
+	AnimScheduler   mAnimLOD;
+	AnimLODInstance mBoxLOD;
+	AnimLODInstance mSkinLOD;
+
 	//==========================================================================================
 	// 디버그 화살표
 	//==========================================================================================
@@ -2,6 +2,7 @@
 
 #include "TutorialApp.h"
 #include "../D3D_Core/pch.h"
+#include "PoseMath.h"
 
 
 bool TutorialApp::InitImGUI()
@@ -55,6 +56,64 @@ static void AnimUI(const char* label,
 	}
 }
 
+// 클립 선택 (라이브러리 안에서 포인터만 교체)
+static void ClipPickUI(const char* label, const AnimClipLibrary* lib, const AnimClip* cur,
+	const std::function<void(size_t)>& setClip)
+{
+	if (!lib || lib->Count() == 0) { ImGui::TextDisabled("No clips."); return; }
+
+	if (ImGui::BeginCombo(label, cur ? cur->name.c_str() : "-")) {
+		for (size_t i = 0; i < lib->Count(); ++i) {
+			const AnimClip* c = lib->Get(i).get();
+			ImGui::PushID((int)i);
+			if (ImGui::Selectable(c->name.c_str(), c == cur)) setClip(i);
+			ImGui::PopID();
+		}
+		ImGui::EndCombo();
+	}
+	ImGui::Text("Library  : %zu clips, %.1f KB", lib->Count(), lib->MemoryBytes() / 1024.0);
+}
+
+// 클립 압축 리포트 (로드 시 측정값)
+static void ClipStatsUI(const AnimClip* clip)
+{
+	if (!clip) return;
+	const AnimCompressStats& s = clip->stats;
+	ImGui::Text("Clip     : %.1f KB -> %.1f KB (x%.2f)", s.rawBytes / 1024.0, s.packedBytes / 1024.0, s.Ratio());
+	if (clip->keyRate > 0.0f)
+		ImGui::Text("Keys     : %u -> %u (uniform, %.3f keys/tick)", s.rawKeys, s.keptKeys, clip->keyRate);
+	else
+		ImGui::Text("Keys     : %u -> %u", s.rawKeys, s.keptKeys);
+	ImGui::Text("Max err  : T %.5f / R %.4f deg / S %.5f", s.maxErrT, s.maxErrRDeg, s.maxErrS);
+}
+
+// 애니메이션 LOD 상태 한 줄
+static void AnimLODUI(const AnimLODInstance& s)
+{
+	ImGui::Text("Anim LOD : %s, %s, %.0f px, eval %u / skip %u", ToString(s.rate),
+		s.visible ? "visible" : "hidden", (s.screenPx > 1e6f) ? 99999.0f : s.screenPx, s.evals, s.skips);
+}
+
+// 메모리 크기 표시 (측정 아님): EvaluatePose가 읽고 쓰는 연속 배열 vs 이름/토폴로지 테이블.
+// 분리 전/후 캐시 미스는 Bench/AnimBench의 cache 섹션 (리눅스 하드웨어 카운터).
+static void FootprintUI(const SkeletonAsset& asset, const PoseInstance& pose)
+{
+	const size_t n = asset.Nodes().size();
+	const size_t hot = n * (sizeof(int) + sizeof(PoseMath::PoseTRS))          // parents, bind
+		+ asset.DynamicNodes().size() * sizeof(int)
+		+ asset.BoneNodes().size() * sizeof(int) + asset.BoneOffsets().size() * sizeof(Matrix)
+		+ pose.local.size() * sizeof(PoseMath::PoseTRS)
+		+ pose.global.size() * sizeof(Matrix) + pose.palette.size() * sizeof(PoseMath::BoneMatrix);
+
+	size_t cold = 0;
+	for (const auto& nd : asset.Nodes())
+		cold += sizeof(SK_Node) + nd.name.capacity() + (nd.children.capacity() + nd.partIndices.capacity()) * sizeof(int);
+	for (const auto& b : asset.Bones())
+		cold += sizeof(SK_Bone) + b.name.capacity();
+
+	ImGui::Text("Footprint: pose arrays %.1f KB / name tables %.1f KB", hot / 1024.0, cold / 1024.0);
+}
+
 //================================================================================================
 
 void TutorialApp::UpdateImGUI()
@@ -263,6 +322,13 @@ void TutorialApp::UpdateImGUI()
 				const double durS = mBoxRig->GetClipDurationSec();
 				ImGui::Text("Ticks/sec: %.3f", tps);
 				ImGui::Text("Duration : %.3f sec", durS);
+				ImGui::Text("Evaluate : %.4f ms", mBoxAC.evalMs);
+				AnimLODUI(mBoxLOD);
+				ClipPickUI("Clip##Box", mBoxRig->GetClipLibrary(), mBoxRig->GetClip(),
+					[&](size_t i) { mBoxRig->SetClip(i); mBoxRig->EvaluatePose(mBoxAC.t); });
+				ClipStatsUI(mBoxRig->GetClip());
+				ImGui::Text("Dynamic  : %zu / %zu nodes (rest cached at load)",
+					mBoxRig->GetDynamicNodeCount(), mBoxRig->GetNodeCount());
 
 				AnimUI("Controls",
 					mBoxAC.play, mBoxAC.loop, mBoxAC.speed, mBoxAC.t,
@@ -294,6 +360,35 @@ void TutorialApp::UpdateImGUI()
 			{
 				const double durS = mSkinRig->DurationSec();
 				ImGui::Text("Duration : %.3f sec", durS);
+				ImGui::Text("Evaluate : %.4f ms", mSkinAC.evalMs);
+				AnimLODUI(mSkinLOD);
+				{
+					const BoundingBox& bb = mSkinRig->Bounds();
+					ImGui::Text("Bounds   : c (%.2f, %.2f, %.2f) e (%.2f, %.2f, %.2f)",
+						bb.Center.x, bb.Center.y, bb.Center.z, bb.Extents.x, bb.Extents.y, bb.Extents.z);
+				}
+				ClipPickUI("Clip##skin", mSkinRig->Clips(), mSkinRig->Clip(),
+					[&](size_t i) { mSkinRig->SetClip(i); mSkinRig->EvaluatePose(mSkinAC.t); });
+				ClipStatsUI(mSkinRig->Clip());
+
+				// 군중용 베이크 재생 (켜면 Evaluate 시간이 거의 0이 되는지 확인)
+				bool baked = mSkinRig->Baked() != nullptr;
+				if (ImGui::Checkbox("Baked playback##skin", &baked)) {
+					mSkinRig->SetBaked(baked);
+					mSkinRig->EvaluatePose(mSkinAC.t);
+				}
+				if (const BakedClip* bk = mSkinRig->Baked()) {
+					ImGui::SameLine();
+					bool lerp = mSkinRig->BakedLerp();
+					if (ImGui::Checkbox("Lerp##bake", &lerp)) mSkinRig->SetBakedLerp(lerp);
+					ImGui::Text("Baked    : %u frames @ %.1f fps, %.1f KB", bk->Frames(), bk->Fps(), bk->MemoryBytes() / 1024.0);
+				}
+				ImGui::Text("Instance : %.1f KB (asset shared by %ld)",
+					mSkinRig->Pose().MemoryBytes() / 1024.0, mSkinRig->Asset().use_count());
+				ImGui::Text("Palette SB : %u / %u mats, uploaded %u (base %u, %zu bones)",
+					mBonePalettes.Used(), mBonePalettes.Capacity(), mBonePalettes.LastUploaded(),
+					mSkinRig->Pose().paletteBase, mSkinRig->Pose().palette.size());
+				FootprintUI(*mSkinRig->Asset(), mSkinRig->Pose());
 
 				AnimUI("Controls##skin",
 					mSkinAC.play, mSkinAC.loop, mSkinAC.speed, mSkinAC.t,
@@ -311,6 +406,27 @@ void TutorialApp::UpdateImGUI()
 		}
 
 
+		// === Animation LOD ===
+		if (ImGui::CollapsingHeader(u8"Animation LOD"))
+		{
+			AnimLODSettings& ls = mAnimLOD.settings;
+			ImGui::Checkbox("Enabled##lod", &ls.enabled);
+			ImGui::DragFloat("Full >= px", &ls.fullPx, 1.0f, 0.0f, 4000.0f, "%.0f");
+			ImGui::DragFloat("1/2 >= px", &ls.halfPx, 1.0f, 0.0f, 4000.0f, "%.0f");
+			ImGui::DragFloat("1/4 >= px", &ls.quarterPx, 1.0f, 0.0f, 4000.0f, "%.0f");
+			bool offFrozen = (ls.offscreen == AnimRate::Frozen);
+			if (ImGui::Checkbox(u8"화면 밖이면 정지", &offFrozen))
+				ls.offscreen = offFrozen ? AnimRate::Frozen : AnimRate::Quarter;
+			ImGui::Text("BoxHuman : "); ImGui::SameLine(); AnimLODUI(mBoxLOD);
+			ImGui::Text("Skinned  : "); ImGui::SameLine(); AnimLODUI(mSkinLOD);
+
+			ImGui::SeparatorText("AnimationSystem");
+			int workers = (int)mAnimSys.Workers();
+			if (ImGui::SliderInt("Workers", &workers, 0, 15)) mAnimSys.SetWorkers((unsigned)workers);
+			ImGui::Text("Update   : %.4f ms (%zu / %zu evaluated)",
+				mAnimSys.LastUpdateMs(), mAnimSys.LastEvaluated(), mAnimSys.Count());
+		}
+
 		// === Toggles / Render Debug ===
 		if (ImGui::CollapsingHeader(u8"Toggles & Debug"))
 		{
@@ -45,37 +45,19 @@ void TutorialApp::OnUpdate()
 
 	const double dt = (double)GameTimer::m_Instance->DeltaTime();
 
-	// --- BoxHuman ---
-	if (mBoxRig) {
-		if (!mDbg.freezeTime && mBoxAC.play) mBoxAC.t += dt * mBoxAC.speed;
-		const double durSec = mBoxRig->GetClipDurationSec();
-		if (durSec > 0.0) {
-			if (mBoxAC.loop) {
-				mBoxAC.t = fmod(mBoxAC.t, durSec); if (mBoxAC.t < 0.0) mBoxAC.t += durSec;
-			}
-			else {
-				if (mBoxAC.t >= durSec) { mBoxAC.t = durSec; mBoxAC.play = false; } // 끝에서 정지
-				if (mBoxAC.t < 0.0) { mBoxAC.t = 0.0;   mBoxAC.play = false; } // 앞에서 정지
-			}
-		}
-		mBoxRig->EvaluatePose(mBoxAC.t, mBoxAC.loop);  // ← loop 전달
+	// 애니메이션 LOD: 직전 프레임 카메라/투영 기준으로 인스턴스별 업데이트 주기 결정.
+	// 시간(t)은 매 프레임 진행하고, 평가하는 프레임에만 그 시간으로 샘플한다.
+	{
+		Matrix camView;
+		m_Camera.GetViewMatrix(camView);
+		mAnimLOD.BeginFrame(camView, m_Projection, (float)m_ClientHeight);
 	}
 
-	// --- Skinned ---
-	if (mSkinRig) {
-		if (!mDbg.freezeTime && mSkinAC.play) mSkinAC.t += dt * mSkinAC.speed;
-		const double durSec = mSkinRig->DurationSec();
-		if (durSec > 0.0) {
-			if (mSkinAC.loop) {
-				mSkinAC.t = fmod(mSkinAC.t, durSec); if (mSkinAC.t < 0.0) mSkinAC.t += durSec;
-			}
-			else {
-				if (mSkinAC.t >= durSec) { mSkinAC.t = durSec; mSkinAC.play = false; }
-				if (mSkinAC.t < 0.0) { mSkinAC.t = 0.0;   mSkinAC.play = false; }
-			}
-		}
-		mSkinRig->EvaluatePose(mSkinAC.t, mSkinAC.loop);
-	}
+	if (mBoxRig)  mAnimLOD.Classify(mBoxLOD, ComposeSRT(mBoxX), mBoxX.enabled);
+	if (mSkinRig) mAnimLOD.Classify(mSkinLOD, ComposeSRT(mSkinX), mSkinX.enabled);
+
+	// 시간 진행 + 평가 대상 선정(직렬) -> 인스턴스별 EvaluatePose(병렬) -> join
+	mAnimSys.Update(dt, !mDbg.freezeTime, &mAnimLOD);
 }
 
 void TutorialApp::OnRender()
@@ -86,6 +68,12 @@ void TutorialApp::OnRender()
 
 	UpdateLightCameraAndShadowCB(ctx); // mLightView, mLightProj, mShadowVP, mCB_Shadow
 
+	// 스키닝 팔레트: 인스턴스마다 상주 슬라이스, 이번 프레임에 포즈가 바뀐 구간만 올린다.
+	// 이후 모든 패스는 오프셋(b4)만 바꾼다
+	if (mSkinRig) mSkinRig->SyncBonePalette(mBonePalettes);
+	mBonePalettes.Upload(ctx);
+	mBonePalettes.Bind(ctx);
+
 	// ───────────────────────────────────────────────────────────────
 	// 1) 기본 파라미터 클램프 + 메인 RT 클리어
 	// ───────────────────────────────────────────────────────────────
@@ -2,6 +2,9 @@
 
 #include "TutorialApp.h"
 #include "../D3D_Core/pch.h"
+#include "CookedMesh.h"
+
+#include <chrono>
 
 
 
@@ -76,12 +79,13 @@ bool TutorialApp::InitScene()
 		HR_T(m_pDevice->CreateVertexShader(vsb->GetBufferPointer(), vsb->GetBufferSize(), nullptr, &m_pSkinnedVS));
 
 		const D3D11_INPUT_ELEMENT_DESC IL_SKIN[] = {
+			// VertexGPU_Skinned (36B)
 			{"POSITION",     0, DXGI_FORMAT_R32G32B32_FLOAT,    0,  0, D3D11_INPUT_PER_VERTEX_DATA, 0},
-			{"NORMAL",       0, DXGI_FORMAT_R32G32B32_FLOAT,    0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0},
-			{"TEXCOORD",     0, DXGI_FORMAT_R32G32_FLOAT,       0, 24, D3D11_INPUT_PER_VERTEX_DATA, 0},
-			{"TANGENT",      0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 32, D3D11_INPUT_PER_VERTEX_DATA, 0},
-			{"BLENDINDICES", 0, DXGI_FORMAT_R8G8B8A8_UINT,      0, 48, D3D11_INPUT_PER_VERTEX_DATA, 0},
-			{"BLENDWEIGHT",  0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 52, D3D11_INPUT_PER_VERTEX_DATA, 0},
+			{"NORMAL",       0, DXGI_FORMAT_R16G16_SNORM,       0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0},
+			{"TANGENT",      0, DXGI_FORMAT_R16G16_UINT,        0, 16, D3D11_INPUT_PER_VERTEX_DATA, 0},
+			{"TEXCOORD",     0, DXGI_FORMAT_R16G16_FLOAT,       0, 20, D3D11_INPUT_PER_VERTEX_DATA, 0},
+			{"BLENDINDICES", 0, DXGI_FORMAT_R16G16B16A16_UINT,  0, 24, D3D11_INPUT_PER_VERTEX_DATA, 0},
+			{"BLENDWEIGHT",  0, DXGI_FORMAT_R8G8B8A8_UNORM,     0, 32, D3D11_INPUT_PER_VERTEX_DATA, 0},
 		};
 		CreateIL(IL_SKIN, _countof(IL_SKIN), vsb, &m_pSkinnedIL);
 	}
@@ -103,14 +107,9 @@ bool TutorialApp::InitScene()
 		if (!m_pUseCB)          MakeCB(sizeof(UseCB), &m_pUseCB);
 		if (!m_pToonCB)			MakeCB(sizeof(ToonCB_), &m_pToonCB);
 
-		// Bone palette (VS b4)
-		if (!m_pBoneCB) {
-			D3D11_BUFFER_DESC cbd{};
-			cbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-			cbd.Usage = D3D11_USAGE_DEFAULT;
-			cbd.ByteWidth = sizeof(DirectX::XMFLOAT4X4) * 256; // 256 bones
-			HR_T(m_pDevice->CreateBuffer(&cbd, nullptr, &m_pBoneCB));
-		}
+		// Bone palette: 본체는 공용 StructuredBuffer(VS t7), b4는 인스턴스별 시작 오프셋만
+		if (!m_pBoneCB) MakeCB(sizeof(BoneBaseCB), &m_pBoneCB);
+		if (!mBonePalettes.Capacity()) mBonePalettes.Init(m_pDevice);
 
 		// PS sampler (linear wrap)
 		if (!m_pSamplerLinear) {
@@ -182,14 +181,21 @@ bool TutorialApp::InitScene()
 	// 7) Load FBX + build GPU
 	// =========================================================
 	{
+		// 원본 옆 .mesh가 최신이면 매핑해서 바로 버퍼 생성, 아니면 Assimp 후 .mesh 갱신
 		auto BuildAll = [&](const std::wstring& fbx, const std::wstring& texDir,
 			StaticMesh& mesh, std::vector<MaterialGPU>& mtls)
 			{
-				MeshData_PNTT cpu;
-				if (!AssimpImporterEx::LoadFBX_PNTT_AndMaterials(fbx, cpu, /*flipUV*/true, /*leftHanded*/true))
+				const auto t0 = std::chrono::steady_clock::now();
+				MappedFile file;
+				MeshData_PNTT imported;
+				CookedMeshView cpu;
+				bool cooked = false;
+				if (!CookedMesh::LoadOrCook(fbx, /*flipUV*/true, /*leftHanded*/true, file, imported, cpu, &cooked))
 					throw std::runtime_error("FBX load failed");
 				if (!mesh.Build(m_pDevice, cpu))
 					throw std::runtime_error("Mesh build failed");
+				const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+				LOG_MESSAGEA("Mesh %.60ls: %s %.2f ms (%u verts)", fbx.c_str(), cooked ? "cooked" : "assimp", ms, cpu.vertexCount);
 
 				mtls.resize(cpu.materials.size());
 				for (size_t i = 0; i < cpu.materials.size(); ++i)
@@ -201,6 +207,9 @@ bool TutorialApp::InitScene()
 		BuildAll(L"../Resource/Zelda/zeldaPosed001.fbx", L"../Resource/Zelda/", gZelda, gZeldaMtls);
 		BuildAll(L"../Resource/BoxHuman/BoxHuman.fbx", L"../Resource/BoxHuman/", gBoxHuman, gBoxMtls);
 
+		// 리그 클립은 기본 설정(키 제거, 리샘플 끔). 균일 리샘플은 필요한 리그만
+		// ResourceManager::SetAnimCompressSettings(fbxPath, cs)로 (쿠커는 --resample-rig)
+
 		mBoxRig = RigidSkeletal::LoadFromFBX(m_pDevice,
 			L"../Resource/BoxHuman/BoxHuman.fbx",
 			L"../Resource/BoxHuman/");
@@ -209,7 +218,14 @@ bool TutorialApp::InitScene()
 			L"../Resource/Skinning/SkinningTest.fbx",
 			L"../Resource/Skinning/");
 
-		if (mSkinRig && m_pBoneCB) mSkinRig->WarmupBoneCB(m_pDeviceContext, m_pBoneCB);
+		if (mSkinRig) mSkinRig->EvaluatePose(0.0); // 첫 프레임 전에 팔레트 준비
+
+		mAnimLOD.Register(mBoxLOD);
+		mAnimLOD.Register(mSkinLOD);
+
+		mAnimSys.Clear();
+		if (mBoxRig)  mAnimSys.Add(mBoxRig.get(), &mBoxAC, &mBoxLOD);
+		if (mSkinRig) mAnimSys.Add(mSkinRig.get(), &mSkinAC, &mSkinLOD);
 	}
 
 	// =========================================================
@@ -492,12 +508,13 @@ bool TutorialApp::CreateDepthOnlyShaders(ID3D11Device* dev)
 
 	// IL: PNTT + Bone
 	static const D3D11_INPUT_ELEMENT_DESC IL_SKIN[] = {
+		// VertexGPU_Skinned (36B)
 		{"POSITION",     0, DXGI_FORMAT_R32G32B32_FLOAT,    0,  0, D3D11_INPUT_PER_VERTEX_DATA, 0},
-		{"NORMAL",       0, DXGI_FORMAT_R32G32B32_FLOAT,    0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0},
-		{"TEXCOORD",     0, DXGI_FORMAT_R32G32_FLOAT,       0, 24, D3D11_INPUT_PER_VERTEX_DATA, 0},
-		{"TANGENT",      0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 32, D3D11_INPUT_PER_VERTEX_DATA, 0},
-		{"BLENDINDICES", 0, DXGI_FORMAT_R8G8B8A8_UINT,      0, 48, D3D11_INPUT_PER_VERTEX_DATA, 0},
-		{"BLENDWEIGHT",  0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 52, D3D11_INPUT_PER_VERTEX_DATA, 0},
+		{"NORMAL",       0, DXGI_FORMAT_R16G16_SNORM,       0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0},
+		{"TANGENT",      0, DXGI_FORMAT_R16G16_UINT,        0, 16, D3D11_INPUT_PER_VERTEX_DATA, 0},
+		{"TEXCOORD",     0, DXGI_FORMAT_R16G16_FLOAT,       0, 20, D3D11_INPUT_PER_VERTEX_DATA, 0},
+		{"BLENDINDICES", 0, DXGI_FORMAT_R16G16B16A16_UINT,  0, 24, D3D11_INPUT_PER_VERTEX_DATA, 0},
+		{"BLENDWEIGHT",  0, DXGI_FORMAT_R8G8B8A8_UNORM,     0, 32, D3D11_INPUT_PER_VERTEX_DATA, 0},
 	};
 	HR_T(dev->CreateInputLayout(IL_SKIN, _countof(IL_SKIN),
 		vsSkin->GetBufferPointer(), vsSkin->GetBufferSize(), mIL_PNTT_BW.GetAddressOf()));
@@ -507,6 +524,8 @@ bool TutorialApp::CreateDepthOnlyShaders(ID3D11Device* dev)
 
 void TutorialApp::UninitScene()
 {
+	mAnimSys.Clear(); // 리그보다 먼저
+
 	// FBX 전용 파이프라인 자원
 	SAFE_RELEASE(m_pMeshIL);
 	SAFE_RELEASE(m_pMeshVS);
@@ -547,6 +566,7 @@ void TutorialApp::UninitScene()
 	SAFE_RELEASE(m_pSkinnedIL);
 	SAFE_RELEASE(m_pSkinnedVS);
 	SAFE_RELEASE(m_pBoneCB);
+	mBonePalettes.Release();
 	//툰툰
 	SAFE_RELEASE(m_pRampSRV);
 	SAFE_RELEASE(m_pToonCB);
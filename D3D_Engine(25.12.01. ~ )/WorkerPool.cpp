@@ -0,0 +1,87 @@
+﻿// WorkerPool.cpp
+// (pch 없이 빌드: 오프라인 쿠커와 공용)
+#include "WorkerPool.h"
+
+#include <algorithm>
+
+unsigned WorkerPool::DefaultWorkers()
+{
+	const unsigned hw = std::thread::hardware_concurrency();
+	return (hw > 1) ? hw - 1 : 0;
+}
+
+void WorkerPool::Resize(unsigned workers)
+{
+	if (workers == mThreads.size()) return;
+	Stop();
+
+	mStop = false;
+	mThreads.reserve(workers);
+	for (unsigned i = 0; i < workers; ++i)
+		mThreads.emplace_back([this] { WorkerLoop(); });
+}
+
+void WorkerPool::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lk(mMutex);
+		mStop = true;
+	}
+	mWake.notify_all();
+	for (auto& t : mThreads) t.join();
+	mThreads.clear();
+}
+
+void WorkerPool::RunChunks()
+{
+	for (;;) {
+		const size_t b = mNext.fetch_add(mGrain, std::memory_order_relaxed);
+		if (b >= mCount) break;
+		(*mFn)(b, std::min(b + mGrain, mCount));
+	}
+}
+
+void WorkerPool::WorkerLoop()
+{
+	uint64_t seen = 0;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lk(mMutex);
+			mWake.wait(lk, [&] { return mStop || mGeneration != seen; });
+			if (mStop) return;
+			seen = mGeneration;
+		}
+
+		RunChunks();
+
+		std::lock_guard<std::mutex> lk(mMutex);
+		if (--mActive == 0) mDone.notify_one();
+	}
+}
+
+void WorkerPool::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn)
+{
+	if (count == 0) return;
+	grain = std::max<size_t>(grain, 1);
+
+	// 워커가 없거나 청크가 하나뿐이면 깨우는 비용이 더 크다
+	if (mThreads.empty() || count <= grain) { fn(0, count); return; }
+
+	{
+		std::lock_guard<std::mutex> lk(mMutex);
+		mFn = &fn;
+		mCount = count;
+		mGrain = grain;
+		mNext.store(0, std::memory_order_relaxed);
+		mActive = (unsigned)mThreads.size();
+		++mGeneration;
+	}
+	mWake.notify_all();
+
+	RunChunks();
+
+	// join: 모든 워커가 이번 세대를 빠져나올 때까지 (mFn 수명 보장)
+	std::unique_lock<std::mutex> lk(mMutex);
+	mDone.wait(lk, [&] { return mActive == 0; });
+	mFn = nullptr;
+}
@@ -0,0 +1,55 @@
+﻿// WorkerPool.h
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//================================================================================================
+// 고정 워커 스레드 풀 (ParallelFor 전용)
+//  - 워커는 한 번 만들어 두고 잠들어 있다가 ParallelFor마다 깨어난다.
+//  - [0, count)를 grain 단위 청크로 쪼개 원자 카운터로 나눠 가짐. 호출 스레드도 같이 일한다.
+//  - ParallelFor는 모든 청크가 끝나야 리턴 (= 렌더 전 join).
+//  - 플랫폼 API 없이 std::thread만 써서 Windows/Linux 공용.
+//================================================================================================
+class WorkerPool
+{
+public:
+    // workers = 호출 스레드 외 추가 스레드 수. 0이면 직렬.
+    explicit WorkerPool(unsigned workers = 0) { Resize(workers); }
+    ~WorkerPool() { Stop(); }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void Resize(unsigned workers);
+    unsigned Workers() const noexcept { return (unsigned)mThreads.size(); }
+
+    // fn(begin, end)를 청크마다 호출. fn은 서로 다른 구간에서 동시에 불린다.
+    void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+    // 기본 워커 수: 하드웨어 스레드 - 1 (호출 스레드 몫)
+    static unsigned DefaultWorkers();
+
+private:
+    void Stop();
+    void WorkerLoop();
+    void RunChunks();
+
+    std::vector<std::thread> mThreads;
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::condition_variable mDone;
+    bool mStop = false;
+    uint64_t mGeneration = 0;          // ParallelFor 한 번 = 한 세대
+
+    // 현재 작업 (세대 동안만 유효)
+    const std::function<void(size_t, size_t)>* mFn = nullptr;
+    size_t mCount = 0, mGrain = 1;
+    std::atomic<size_t> mNext{ 0 };
+    unsigned mActive = 0;              // 아직 이번 세대를 끝내지 않은 워커 수 (mMutex 보호)
+};
@@ -1,12 +1,11 @@
 #define SKINNED 1
 #include "Shared.hlsli"
 
+// 압축 스킨 정점(VertexGPU_Skinned)에서 위치/UV/본만 읽는다 (노멀/탄젠트는 안 씀)
 struct VS_IN
 {
     float3 Pos : POSITION;
-    float3 Norm : NORMAL;
     float2 Tex : TEXCOORD0;
-    float4 Tang : TANGENT;
     uint4 BlendIndices : BLENDINDICES;
     float4 BlendWeight : BLENDWEIGHT;
 };
@@ -20,17 +19,10 @@ struct VS_OUT
 
 VS_OUT main(VS_IN i)
 {
-    // 스키닝(4본 가정. 너의 Shared.hlsli에 BonePalette[b4]가 있을 것)
-    uint4 bi = i.BlendIndices;
-    float4 bw = i.BlendWeight;
+    // 스키닝(4본 가정. SkinMatrix/BonePalette(t7)/gBoneBase(b4)는 Shared.hlsli)
+    float3x4 B = SkinMatrix(i.BlendIndices, i.BlendWeight);
 
-    float4x4 B =
-          bw.x * BonePalette[bi.x]
-        + bw.y * BonePalette[bi.y]
-        + bw.z * BonePalette[bi.z]
-        + bw.w * BonePalette[bi.w];
-
-    float4 P = mul(float4(i.Pos, 1), B);
+    float4 P = float4(mul(B, float4(i.Pos, 1)), 1);
     float4 Pw = mul(P, World);
 
     VS_OUT o;
@@ -68,16 +68,36 @@ cbuffer ToonCB : register(b7)
 struct VS_INPUT
 {
     float3 Pos : POSITION;
+#if defined(SKINNED)
+    // 압축 스킨 정점 (VertexGPU_Skinned 36B). 디코드는 OctDecode / DecodeTangentOct
+    float2 NormOct : NORMAL;        // SNORM16 x2
+    float2 Tex : TEXCOORD0;         // half x2
+    uint2  TangOct : TANGENT;       // x 16bit, y 15bit + handedness 1bit
+    uint4  BlendIndices : BLENDINDICES;
+    float4 BlendWeights : BLENDWEIGHT; // UNORM8 x4 (합 1)
+#else
     float3 Norm : NORMAL;
     float2 Tex : TEXCOORD0;
     float4 Tang : TANGENT; // (= TANGENT0)
-
-#if defined(SKINNED)
-    uint4  BlendIndices : BLENDINDICES;
-    float4 BlendWeights : BLENDWEIGHT;
 #endif
 };
 
+// 팔면체 [-1, 1]^2 -> 단위 벡터
+float3 OctDecode(float2 e)
+{
+    float3 n = float3(e, 1.0f - abs(e.x) - abs(e.y));
+    float t = saturate(-n.z);
+    n.xy += (n.xy >= 0.0f) ? -t : t;
+    return normalize(n);
+}
+
+// 압축 탄젠트 -> (xyz, handedness)
+float4 DecodeTangentOct(uint2 q)
+{
+    float2 e = float2(q.x / 65535.0f, (q.y >> 1) / 32767.0f) * 2.0f - 1.0f;
+    return float4(OctDecode(e), (q.y & 1u) ? -1.0f : 1.0f);
+}
+
 // ===== PS input
 struct PS_INPUT
 {
@@ -163,12 +183,36 @@ float SampleShadow_PCF(float3 worldPos, float3 Nw)
         }
     return acc / 9.0f;
 }
-// ===== Bones (b4) — Shared에만 둔다!
-static const uint kMaxBones = 256;
+// ===== Bones (t7 + b4) — Shared에만 둔다!
+// 팔레트는 모든 스키닝 인스턴스가 StructuredBuffer 하나를 같이 쓰고(C++: BonePaletteBuffer),
+// 드로우마다 b4의 gBoneBase로 자기 구간을 고른다. 본 개수 제한 없음(인덱스 16bit).
 #if defined(SKINNED)
+// 본 하나 = affine 3x4 (48B). 행 k = CPU 행렬(행 벡터 규약)의 k번째 열, 4번째 열 (0,0,0,1)은 생략
+struct Bone3x4
+{
+    float4 r0;
+    float4 r1;
+    float4 r2;
+};
+StructuredBuffer<Bone3x4> BonePalette : register(t7);
 cbuffer Bones : register(b4)
 {
-    float4x4 BonePalette[kMaxBones];
+    uint gBoneBase;
+    uint3 _bonePad;
+}
+
+// 4본 가중 합. 결과는 mul(B, float4(p, 1)) / mul((float3x3)B, n) 으로 쓴다.
+float3x4 SkinMatrix(uint4 bi, float4 bw)
+{
+    bi += gBoneBase;
+    Bone3x4 a = BonePalette[bi.x];
+    Bone3x4 b = BonePalette[bi.y];
+    Bone3x4 c = BonePalette[bi.z];
+    Bone3x4 d = BonePalette[bi.w];
+    return float3x4(
+        bw.x * a.r0 + bw.y * b.r0 + bw.z * c.r0 + bw.w * d.r0,
+        bw.x * a.r1 + bw.y * b.r1 + bw.z * c.r1 + bw.w * d.r1,
+        bw.x * a.r2 + bw.y * b.r2 + bw.z * c.r2 + bw.w * d.r2);
 }
 #endif
 
@@ -3,25 +3,25 @@
 PS_INPUT main(VS_INPUT i)
 {
     float4 Pobj = float4(i.Pos, 1.0f);
+#if defined(SKINNED)
+    float3 Nobj = OctDecode(i.NormOct);
+    float4 T = DecodeTangentOct(i.TangOct);
+    float3 Tobj = T.xyz;
+    float signT = T.w;
+#else
     float3 Nobj = i.Norm;
     float3 Tobj = i.Tang.xyz;
     float signT = i.Tang.w;
+#endif
 
 #if defined(SKINNED)
-    uint4  bi = i.BlendIndices;
-    float4 bw = i.BlendWeights;
-
-    // 행렬 저장/곱 순서에 따라 전치가 필요할 수 있음 (틀어지면 transpose 시도)
-    float4x4 B =
-          bw.x * BonePalette[bi.x]
-        + bw.y * BonePalette[bi.y]
-        + bw.z * BonePalette[bi.z]
-        + bw.w * BonePalette[bi.w];
+    // 3x4 팔레트: 열 벡터 쪽으로 곱한다 (CPU가 전치해서 저장)
+    float3x4 B = SkinMatrix(i.BlendIndices, i.BlendWeights);
 
-    Pobj = mul(Pobj, B);
+    Pobj = float4(mul(B, Pobj), 1.0f);
     float3x3 B3 = (float3x3)B;
-    Nobj = mul(Nobj, B3);
-    Tobj = mul(Tobj, B3);
+    Nobj = mul(B3, Nobj);
+    Tobj = mul(B3, Tobj);
 #endif
 
     float4 Pw = mul(Pobj, World);